@@ -14,9 +14,132 @@
 #include "caps.h"
 // Inclui o cabealho das funes de eleitores
 #include "eleitores.h"
+// Inclui o cabealho da pilha de votos (histrico das urnas)
+#include "pilhas.h"
+// Inclui o cabealho da contagem paralela dos histricos das urnas
+#include "apuracao_paralela.h"
 
 // ================= IMPLEMENTAO SISTEMA DE APURAO =================
 
+// Cria uma rvore de resultados j com o ndice de nomes ativo, para que
+// as consultas por nome (regies, locais de CAP, candidatos) sejam O(1)
+static ArvoreResultados* criar_arvore_indexada(TipoNoArvore tipo) {
+    // Cria a rvore vazia do tipo pedido
+    ArvoreResultados* arvore = criar_arvore_resultados(tipo);
+    // Sem memria para o ndice a rvore continua vlida, s sem o atalho
+    if (arvore) ativar_indice_nomes(arvore);
+    return arvore;
+}
+
+// Monta a rvore de uma vez a partir dos resultados j calculados e troca a
+// antiga por ela; sem memria a rvore antiga  mantida
+static int substituir_arvore(ArvoreResultados** destino, TipoNoArvore tipo,
+                             ResultadoVotacao* resultados, int quantidade) {
+    // Constri a nova rvore balanceada num s bloco
+    ArvoreResultados* arvore = construir_arvore_resultados(tipo, resultados, quantidade);
+    if (!arvore) return 0;
+    // Mesmo atalho de busca por nome das rvores criadas vazias
+    ativar_indice_nomes(arvore);
+    
+    // Destri a rvore anterior e publica a nova
+    destruir_arvore_resultados(*destino);
+    *destino = arvore;
+    return 1;
+}
+
+// Leva a marca de cada urna ao fim do seu histrico: tudo o que j est
+// nele acabou de entrar numa apurao completa
+static void marcar_urnas_apuradas(ListaCAPs* caps) {
+    // Percorre todos os CAPs
+    for (int i = 0; i < caps->tamanho; i++) {
+        CAP* cap = &caps->caps[i];
+        // CAP sem urnas alocadas no tem histrico
+        if (!cap->urnas) continue;
+        // Percorre as urnas do CAP
+        for (int j = 0; j < cap->num_urnas; j++) {
+            Urna* urna = cap->urnas[j];
+            if (urna && urna->historico_votos) {
+                urna->votos_apurados = tamanho_pilha_votos(urna->historico_votos);
+            }
+        }
+    }
+}
+
+// Aplica s rvores s o que mudou desde a ltima apurao: os CAPs que
+// atenderam eleitores ou receberam votos esto nas pendncias da lista, e
+// de cada um entram os votos das urnas depois da marca e a diferena de
+// eleitores atendidos. Custa O(CAPs pendentes + votos novos). Retorna 0
+// quando as rvores no refletem mais os cadastros; a  preciso apurar
+// tudo de novo
+static int apurar_votos_novos(SistemaApuracao* sistema, ListaCandidatos* candidatos,
+                              ListaCAPs* caps, int total_eleitores) {
+    // As pendncias s valem para o sistema que fez a ltima apurao
+    PendenciasApuracao* pendencias = caps->pendencias;
+    if (!pendencias || pendencias->invalida || pendencias->dono != sistema) return 0;
+    // As rvores precisam existir e ter exatamente os candidatos e CAPs atuais
+    if (!sistema->arvore_candidatos || !sistema->arvore_caps || !sistema->arvore_regioes) return 0;
+    if (total_nos_arvore(sistema->arvore_candidatos) != candidatos->tamanho) return 0;
+    if (total_nos_arvore(sistema->arvore_caps) != caps->tamanho) return 0;
+    
+    int votos_novos = 0;
+    for (int p = 0; p < pendencias->quantidade; p++) {
+        CAP* cap = &caps->caps[pendencias->caps[p]];
+        
+        // 1. Votos novos de cada urna do CAP, da marca at o fim do histrico
+        for (int j = 0; cap->urnas && j < cap->num_urnas; j++) {
+            Urna* urna = cap->urnas[j];
+            if (!urna || !urna->historico_votos) continue;
+            
+            int fim = tamanho_pilha_votos(urna->historico_votos);
+            // Histrico menor que a marca: votos foram retirados
+            if (fim < urna->votos_apurados) return 0;
+            for (int k = urna->votos_apurados; k < fim; k++) {
+                Voto* voto = voto_na_posicao(urna->historico_votos, k);
+                // Candidato fora da rvore: cadastro mudou desde a apurao
+                if (!atualizar_votos_resultado(sistema->arvore_candidatos, voto->numero_candidato, 1)) {
+                    return 0;
+                }
+                votos_novos++;
+            }
+            // Avana a marca da urna
+            urna->votos_apurados = fim;
+        }
+        
+        // 2. CAP e regio: s a diferena de eleitores atendidos
+        ResultadoVotacao* resultado_cap = buscar_resultado_por_id(sistema->arvore_caps, cap->id);
+        if (!resultado_cap) return 0;
+        
+        int diferenca = cap->eleitores_atendidos - resultado_cap->votos;
+        if (diferenca != 0) {
+            atualizar_votos_resultado(sistema->arvore_caps, cap->id, diferenca);
+            // Mesmo ID que a apurao completa d  regio
+            int id_regiao = criar_resultado_regiao(cap->regiao, 0, 0).id;
+            if (!atualizar_votos_resultado(sistema->arvore_regioes, id_regiao, diferenca)) return 0;
+        }
+    }
+    // Os contadores dos candidatos s sobem em registrar_voto_urna, junto
+    // com o voto na urna: somar os votos novos d o mesmo total da recontagem
+    sistema->total_votos_validos += votos_novos;
+    
+    // 3. Participao geral, pela mesma conta da apurao completa; a rvore
+    // de CAPs guarda os eleitores atendidos e a soma dela sai da raiz
+    int eleitores_votaram = soma_votos_arvore(sistema->arvore_caps);
+    sistema->total_eleitores = total_eleitores;
+    if (sistema->total_eleitores > 0) {
+        sistema->participacao_geral = (float)eleitores_votaram / 
+                                     sistema->total_eleitores * 100;
+    } else {
+        sistema->participacao_geral = 0.0;
+    }
+    
+    // Tudo o que estava pendente entrou nas rvores
+    limpar_pendencias_caps(caps, sistema);
+    
+    // Exibe o resumo da atualizao
+    printf("Apuracao atualizada: %d votos novos aplicados\n", votos_novos);
+    return 1;
+}
+
 // Funo que cria e inicializa um novo sistema de apurao
 SistemaApuracao* criar_sistema_apuracao() {
     // Aloca memria para a estrutura SistemaApuracao
@@ -24,11 +147,11 @@ SistemaApuracao* criar_sistema_apuracao() {
     // Verifica se a alocao foi bem sucedida
     if (sistema) {
         // Cria uma rvore de resultados para candidatos
-        sistema->arvore_candidatos = criar_arvore_resultados(TIPO_CANDIDATO);
+        sistema->arvore_candidatos = criar_arvore_indexada(TIPO_CANDIDATO);
         // Cria uma rvore de resultados para CAPs
-        sistema->arvore_caps = criar_arvore_resultados(TIPO_CAP);
+        sistema->arvore_caps = criar_arvore_indexada(TIPO_CAP);
         // Cria uma rvore de resultados para regies
-        sistema->arvore_regioes = criar_arvore_resultados(TIPO_REGIAO);
+        sistema->arvore_regioes = criar_arvore_indexada(TIPO_REGIAO);
         // Inicializa o total de votos vlidos com zero
         sistema->total_votos_validos = 0;
         // Inicializa o total de votos em branco com zero
@@ -80,8 +203,11 @@ void inicializar_apuracao(SistemaApuracao* sistema, ListaCandidatos* candidatos,
     // Calcula o total de eleitores (tamanho da lista de eleitores)
     sistema->total_eleitores = eleitores->tamanho;
     
-    // Chama a funo para apurar todos os resultados
-    apurar_resultados_completos(sistema, candidatos, caps, eleitores);
+    // Com as rvores de uma apurao anterior basta aplicar os votos novos;
+    // seno (primeira vez, cadastros alterados) apura tudo
+    if (!apurar_votos_novos(sistema, candidatos, caps, eleitores->tamanho)) {
+        apurar_resultados_completos(sistema, candidatos, caps, eleitores);
+    }
     
     // Exibe mensagem de sucesso
     printf("Sistema de apuracao inicializado com sucesso!\n");
@@ -89,6 +215,32 @@ void inicializar_apuracao(SistemaApuracao* sistema, ListaCandidatos* candidatos,
     printf("Total de eleitores: %d\n", sistema->total_eleitores);
 }
 
+// ================= IMPLEMENTAO APURAO DA SESSO =================
+
+// Apurao mantida entre as consultas do menu: as rvores ficam prontas e
+// cada consulta s aplica o que mudou desde a anterior
+static SistemaApuracao* apuracao_sessao = NULL;
+
+// Funo que devolve a apurao da sesso, criada na primeira chamada e
+// atualizada nas seguintes
+SistemaApuracao* obter_apuracao_sessao(ListaCandidatos* candidatos, ListaCAPs* caps, 
+                                       ListaEleitores* eleitores) {
+    // Cria o sistema na primeira consulta
+    if (!apuracao_sessao) {
+        apuracao_sessao = criar_sistema_apuracao();
+        if (!apuracao_sessao) return NULL;
+    }
+    // Aplica o que mudou desde a consulta anterior
+    inicializar_apuracao(apuracao_sessao, candidatos, caps, eleitores);
+    return apuracao_sessao;
+}
+
+// Funo que libera a apurao da sesso
+void destruir_apuracao_sessao() {
+    destruir_sistema_apuracao(apuracao_sessao);
+    apuracao_sessao = NULL;
+}
+
 // ================= IMPLEMENTAO APURAO DE VOTOS =================
 
 // Funo para apurar os votos dos candidatos
@@ -96,14 +248,6 @@ int apurar_votos_candidatos(SistemaApuracao* sistema, ListaCandidatos* candidato
     // Verifica se os parmetros so vlidos
     if (!sistema || !candidatos) return 0;
     
-    // Limpa a rvore existente de candidatos, se houver
-    if (sistema->arvore_candidatos) {
-        // Destri a rvore atual
-        destruir_arvore_resultados(sistema->arvore_candidatos);
-        // Cria uma nova rvore vazia
-        sistema->arvore_candidatos = criar_arvore_resultados(TIPO_CANDIDATO);
-    }
-    
     // Calcula o total de votos vlidos
     sistema->total_votos_validos = 0;
     // Percorre todos os candidatos
@@ -112,18 +256,25 @@ int apurar_votos_candidatos(SistemaApuracao* sistema, ListaCandidatos* candidato
         sistema->total_votos_validos += candidatos->candidatos[i].votos;
     }
     
-    // Insere cada candidato na rvore
+    // Vetor com o resultado de cada candidato, para a carga em lote
+    ResultadoVotacao* resultados = (ResultadoVotacao*)malloc(
+        (candidatos->tamanho > 0 ? candidatos->tamanho : 1) * sizeof(ResultadoVotacao));
+    if (!resultados) return 0;
+    
+    // Cria um resultado de votao para cada candidato
     for (int i = 0; i < candidatos->tamanho; i++) {
-        // Cria um resultado de votao para o candidato
-        ResultadoVotacao resultado = criar_resultado_candidato(
+        resultados[i] = criar_resultado_candidato(
             &candidatos->candidatos[i], 
             sistema->total_votos_validos
         );
-        
-        // Insere o resultado na rvore
-        inserir_resultado_arvore(sistema->arvore_candidatos, resultado);
     }
     
+    // Troca a rvore de candidatos pela montada em lote
+    int ok = substituir_arvore(&sistema->arvore_candidatos, TIPO_CANDIDATO,
+                               resultados, candidatos->tamanho);
+    free(resultados);
+    if (!ok) return 0;
+    
     // Atualiza os percentuais na rvore
     atualizar_percentuais_arvore(sistema->arvore_candidatos);
     
@@ -140,31 +291,29 @@ int apurar_votos_caps(SistemaApuracao* sistema, ListaCAPs* caps) {
     // Verifica se os parmetros so vlidos
     if (!sistema || !caps) return 0;
     
-    // Limpa a rvore existente de CAPs, se houver
-    if (sistema->arvore_caps) {
-        // Destri a rvore atual
-        destruir_arvore_resultados(sistema->arvore_caps);
-        // Cria uma nova rvore vazia
-        sistema->arvore_caps = criar_arvore_resultados(TIPO_CAP);
-    }
-    
     // Varivel para armazenar o total de votos em CAPs
     int total_votos_caps = 0;
     
-    // Insere cada CAP na rvore
+    // Vetor com o resultado de cada CAP, para a carga em lote
+    ResultadoVotacao* resultados = (ResultadoVotacao*)malloc(
+        (caps->tamanho > 0 ? caps->tamanho : 1) * sizeof(ResultadoVotacao));
+    if (!resultados) return 0;
+    
     for (int i = 0; i < caps->tamanho; i++) {
         // Cria um resultado de votao para o CAP
-        ResultadoVotacao resultado = criar_resultado_cap(
+        resultados[i] = criar_resultado_cap(
             &caps->caps[i], 
             sistema->total_votos_validos
         );
-        
-        // Insere o resultado na rvore
-        inserir_resultado_arvore(sistema->arvore_caps, resultado);
         // Soma os eleitores atendidos por este CAP
         total_votos_caps += caps->caps[i].eleitores_atendidos;
     }
     
+    // Troca a rvore de CAPs pela montada em lote
+    int ok = substituir_arvore(&sistema->arvore_caps, TIPO_CAP, resultados, caps->tamanho);
+    free(resultados);
+    if (!ok) return 0;
+    
     // Atualiza os percentuais na rvore
     atualizar_percentuais_arvore(sistema->arvore_caps);
     
@@ -241,26 +390,22 @@ int apurar_votos_regioes(SistemaApuracao* sistema, ListaCAPs* caps) {
         }
     }
     
-    // Limpa a rvore existente de regies, se houver
-    if (sistema->arvore_regioes) {
-        // Destri a rvore atual
-        destruir_arvore_resultados(sistema->arvore_regioes);
-        // Cria uma nova rvore vazia
-        sistema->arvore_regioes = criar_arvore_resultados(TIPO_REGIAO);
-    }
+    // Vetor com o resultado de cada regio, na ordem da lista, para a carga em lote
+    ResultadoVotacao* resultados = (ResultadoVotacao*)malloc(
+        (total_regioes > 0 ? total_regioes : 1) * sizeof(ResultadoVotacao));
+    int quantidade = 0;
     
-    // Percorre a lista ligada de regies e insere na rvore
+    // Percorre a lista ligada de regies, preenchendo o vetor e liberando os ns
     RegiaoVotos* atual = lista_regioes;
     while (atual != NULL) {
         // Cria um resultado de votao para a regio
-        ResultadoVotacao resultado = criar_resultado_regiao(
-            atual->nome,
-            atual->votos,
-            sistema->total_votos_validos
-        );
-        
-        // Insere o resultado na rvore
-        inserir_resultado_arvore(sistema->arvore_regioes, resultado);
+        if (resultados) {
+            resultados[quantidade++] = criar_resultado_regiao(
+                atual->nome,
+                atual->votos,
+                sistema->total_votos_validos
+            );
+        }
         
         // Salva o prximo n antes de liberar o atual
         RegiaoVotos* proximo = atual->proximo;
@@ -269,6 +414,12 @@ int apurar_votos_regioes(SistemaApuracao* sistema, ListaCAPs* caps) {
         // Avana para o prximo n
         atual = proximo;
     }
+    if (!resultados) return 0;
+    
+    // Troca a rvore de regies pela montada em lote
+    int ok = substituir_arvore(&sistema->arvore_regioes, TIPO_REGIAO, resultados, quantidade);
+    free(resultados);
+    if (!ok) return 0;
     
     // Atualiza os percentuais na rvore
     atualizar_percentuais_arvore(sistema->arvore_regioes);
@@ -280,6 +431,43 @@ int apurar_votos_regioes(SistemaApuracao* sistema, ListaCAPs* caps) {
     return 1;
 }
 
+// Calcula a participao geral a partir dos eleitores atendidos nos CAPs e
+// retorna quantos eleitores votaram
+static int calcular_participacao(SistemaApuracao* sistema, ListaCAPs* caps,
+                                 ListaEleitores* eleitores) {
+    int eleitores_votaram = 0;
+    // Percorre todos os CAPs somando os eleitores atendidos
+    for (int i = 0; i < caps->tamanho; i++) {
+        eleitores_votaram += caps->caps[i].eleitores_atendidos;
+    }
+    
+    // Atualiza o total de eleitores no sistema
+    sistema->total_eleitores = eleitores->tamanho;
+    
+    // Calcula a porcentagem de participao
+    if (sistema->total_eleitores > 0) {
+        // Calcula: (eleitores que votaram / total de eleitores) * 100
+        sistema->participacao_geral = (float)eleitores_votaram / 
+                                     sistema->total_eleitores * 100;
+    } else {
+        // Se no h eleitores, participao  zero
+        sistema->participacao_geral = 0.0;
+    }
+    return eleitores_votaram;
+}
+
+// Fecha uma apurao completa: com todas as rvores trocadas, os votos que
+// j esto nas urnas entraram nela; seno a prxima atualizao tambm tem
+// de ser completa (pendncias sem dono)
+static void concluir_apuracao(SistemaApuracao* sistema, ListaCAPs* caps, int apurado) {
+    if (apurado) {
+        marcar_urnas_apuradas(caps);
+        limpar_pendencias_caps(caps, sistema);
+    } else {
+        limpar_pendencias_caps(caps, NULL);
+    }
+}
+
 // Funo para apurar todos os resultados (candidatos, CAPs e regies)
 void apurar_resultados_completos(SistemaApuracao* sistema, ListaCandidatos* candidatos, 
                                 ListaCAPs* caps, ListaEleitores* eleitores) {
@@ -291,35 +479,21 @@ void apurar_resultados_completos(SistemaApuracao* sistema, ListaCandidatos* cand
     
     // 1. Apura votos dos candidatos
     printf("1. Apurando votos dos candidatos...\n");
-    apurar_votos_candidatos(sistema, candidatos);
+    int apurado = apurar_votos_candidatos(sistema, candidatos);
     
     // 2. Apura votos dos CAPs
     printf("2. Apurando votos dos CAPs...\n");
-    apurar_votos_caps(sistema, caps);
+    apurado = apurar_votos_caps(sistema, caps) && apurado;
     
     // 3. Apura votos por regio
     printf("3. Apurando votos por regiao...\n");
-    apurar_votos_regioes(sistema, caps);
+    apurado = apurar_votos_regioes(sistema, caps) && apurado;
     
     // 4. Calcula a participao geral (porcentagem de eleitores que votaram)
-    int eleitores_votaram = 0;
-    // Percorre todos os CAPs somando os eleitores atendidos
-    for (int i = 0; i < caps->tamanho; i++) {
-        eleitores_votaram += caps->caps[i].eleitores_atendidos;
-    }
+    int eleitores_votaram = calcular_participacao(sistema, caps, eleitores);
     
-    // Atualiza o total de eleitores no sistema
-    sistema->total_eleitores = eleitores->tamanho;
-    
-    // Calcula a porcentagem de participao
-    if (sistema->total_eleitores > 0) {
-        // Calcula: (eleitores que votaram / total de eleitores) * 100
-        sistema->participacao_geral = (float)eleitores_votaram / 
-                                     sistema->total_eleitores * 100;
-    } else {
-        // Se no h eleitores, participao  zero
-        sistema->participacao_geral = 0.0;
-    }
+    // Marca urnas e pendncias conforme o resultado da apurao
+    concluir_apuracao(sistema, caps, apurado);
     
     // Exibe resumo da apurao
     printf("\n=== APURACAO CONCLUIDA ===\n");
@@ -329,71 +503,93 @@ void apurar_resultados_completos(SistemaApuracao* sistema, ListaCandidatos* cand
     printf("Votos validos: %d\n", sistema->total_votos_validos);
 }
 
-// Funo para atualizar a apurao com um novo voto (em tempo real)
-int atualizar_apuracao_com_voto(SistemaApuracao* sistema, Voto* voto, 
-                               ListaCandidatos* candidatos, ListaCAPs* caps) {
+// Funo que reconta em paralelo os histricos das urnas e publica o
+// resultado. Os votos dos candidatos saem das urnas; CAPs, regies e
+// participao seguem as contas da apurao completa. As rvores s mudam
+// se as urnas cobrirem os votos contados: cada candidato precisa ter nelas
+// exatamente os votos do seu contador
+int recontar_votos_urnas(SistemaApuracao* sistema, ListaCandidatos* candidatos, 
+                         ListaCAPs* caps, ListaEleitores* eleitores, int num_threads) {
     // Verifica se todos os parmetros so vlidos
-    if (!sistema || !voto || !candidatos || !caps) return 0;
+    if (!sistema || !candidatos || !caps || !eleitores) return 0;
     
-    // Incrementa o contador de votos vlidos
-    sistema->total_votos_validos++;
+    // Conta os histricos de todas as urnas
+    ContagemVotos contagem;
+    if (!contar_votos_urnas_paralelo(candidatos, caps, num_threads, &contagem)) return 0;
     
-    // Busca o resultado do candidato votado na rvore
-    ResultadoVotacao* resultado_candidato = buscar_resultado_por_id(
-        sistema->arvore_candidatos, 
-        voto->numero_candidato
-    );
-    
-    // Verifica se o candidato j existe na rvore
-    if (resultado_candidato) {
-        // Candidato existe: incrementa seu contador de votos
-        resultado_candidato->votos++;
-    } else {
-        // Candidato no encontrado: pode ser um novo candidato
-        Candidato* candidato = buscar_candidato_por_numero(candidatos, voto->numero_candidato);
-        if (candidato) {
-            // Cria um novo resultado para o candidato
-            ResultadoVotacao novo_resultado = criar_resultado_candidato(
-                candidato, 
-                sistema->total_votos_validos
-            );
-            // Insere o novo resultado na rvore
-            inserir_resultado_arvore(sistema->arvore_candidatos, novo_resultado);
-        }
+    // Confere a contagem com os contadores antes de mexer nas rvores
+    int cobre = contagem.votos_ignorados == 0;
+    for (int i = 0; cobre && i < candidatos->tamanho; i++) {
+        cobre = contagem.votos_candidatos[i] == candidatos->candidatos[i].votos;
+    }
+    if (!cobre) {
+        printf("As urnas nao cobrem os votos contados (%lld votos nas urnas); apuracao mantida.\n",
+               contagem.votos_contados + contagem.votos_ignorados);
+        liberar_contagem_votos(&contagem);
+        return 0;
     }
     
-    // Busca o resultado do CAP onde o voto foi registrado
-    ResultadoVotacao* resultado_cap = buscar_resultado_por_id(
-        sistema->arvore_caps, 
-        voto->id_cap
-    );
+    // 1. Candidatos, com os votos contados nas urnas
+    int total = (int)contagem.votos_contados;
+    ResultadoVotacao* resultados = (ResultadoVotacao*)malloc(
+        (candidatos->tamanho > 0 ? candidatos->tamanho : 1) * sizeof(ResultadoVotacao));
+    if (!resultados) {
+        liberar_contagem_votos(&contagem);
+        return 0;
+    }
+    for (int i = 0; i < candidatos->tamanho; i++) {
+        resultados[i] = criar_resultado_candidato(&candidatos->candidatos[i], total);
+        resultados[i].votos = contagem.votos_candidatos[i];
+        resultados[i].votos_validos = contagem.votos_candidatos[i];
+    }
+    liberar_contagem_votos(&contagem);
     
-    // Verifica se o CAP j existe na rvore
-    if (resultado_cap) {
-        // CAP existe: incrementa seu contador de votos
-        resultado_cap->votos++;
-    } else {
-        // CAP no encontrado: busca na lista de CAPs
-        for (int i = 0; i < caps->tamanho; i++) {
-            if (caps->caps[i].id == voto->id_cap) {
-                // Cria um novo resultado para o CAP
-                ResultadoVotacao novo_resultado = criar_resultado_cap(
-                    &caps->caps[i], 
-                    sistema->total_votos_validos
-                );
-                // Insere o novo resultado na rvore
-                inserir_resultado_arvore(sistema->arvore_caps, novo_resultado);
-                break; // Sai do loop aps encontrar
-            }
-        }
+    int apurado = substituir_arvore(&sistema->arvore_candidatos, TIPO_CANDIDATO,
+                                    resultados, candidatos->tamanho);
+    free(resultados);
+    if (apurado) {
+        atualizar_percentuais_arvore(sistema->arvore_candidatos);
+        sistema->total_votos_validos = total;
+        // As urnas s aceitam votos em candidatos cadastrados
+        sistema->total_votos_brancos = 0;
+        sistema->total_votos_nulos = 0;
     }
     
-    // Atualiza os percentuais em ambas as rvores
-    atualizar_percentuais_arvore(sistema->arvore_candidatos);
-    atualizar_percentuais_arvore(sistema->arvore_caps);
+    // 2. e 3. CAPs e regies pelos eleitores atendidos
+    apurado = apurar_votos_caps(sistema, caps) && apurado;
+    apurado = apurar_votos_regioes(sistema, caps) && apurado;
     
-    // Retorna 1 indicando sucesso
-    return 1;
+    // 4. Participao geral
+    calcular_participacao(sistema, caps, eleitores);
+    
+    // Marca urnas e pendncias conforme o resultado da recontagem
+    concluir_apuracao(sistema, caps, apurado);
+    
+    // Exibe resumo da recontagem
+    printf("Recontagem das urnas: %d votos validos, participacao %.2f%%\n",
+           sistema->total_votos_validos, sistema->participacao_geral);
+    return apurado;
+}
+
+// Funo para atualizar a apurao com um novo voto (em tempo real).
+// O voto j est no histrico da urna e o CAP dele nas pendncias (ver
+// registrar_voto_urna), ento ele entra pela atualizao incremental, que
+// o conta uma nica vez e avana a marca da urna; som-lo direto nas
+// rvores faria a prxima atualizao cont-lo de novo
+int atualizar_apuracao_com_voto(SistemaApuracao* sistema, Voto* voto, 
+                               ListaCandidatos* candidatos, ListaCAPs* caps) {
+    // Verifica se todos os parmetros so vlidos
+    if (!sistema || !voto || !candidatos || !caps) return 0;
+    
+    // O voto no muda o cadastro de eleitores: vale o total j apurado
+    if (apurar_votos_novos(sistema, candidatos, caps, sistema->total_eleitores)) {
+        return 1;
+    }
+    
+    // rvores desatualizadas (ou aplicadas s em parte): a prxima
+    // apurao tem de ser completa
+    if (caps->pendencias) caps->pendencias->invalida = true;
+    return 0;
 }
 
 // ================= IMPLEMENTAO CONSULTAS E RELATRIOS =================
@@ -543,6 +739,8 @@ void consultar_todos_resultados(SistemaApuracao* sistema) {
 ResultadoVotacao* consultar_candidato_por_numero(SistemaApuracao* sistema, int numero) {
     // Retorna NULL se o sistema for invlido
     if (!sistema) return NULL;
+    // Garante percentuais em dia antes de entregar o resultado
+    atualizar_percentuais_arvore(sistema->arvore_candidatos);
     // Busca o candidato na rvore pelo ID (nmero)
     return buscar_resultado_por_id(sistema->arvore_candidatos, numero);
 }
@@ -551,6 +749,8 @@ ResultadoVotacao* consultar_candidato_por_numero(SistemaApuracao* sistema, int n
 ResultadoVotacao* consultar_cap_por_id(SistemaApuracao* sistema, int id) {
     // Retorna NULL se o sistema for invlido
     if (!sistema) return NULL;
+    // Garante percentuais em dia antes de entregar o resultado
+    atualizar_percentuais_arvore(sistema->arvore_caps);
     // Busca o CAP na rvore pelo ID
     return buscar_resultado_por_id(sistema->arvore_caps, id);
 }
@@ -582,6 +782,10 @@ void gerar_relatorio_completo(SistemaApuracao* sistema) {
     if (vencedor) {
         printf("CANDIDATO MAIS VOTADO:\n");
         exibir_resultado_formatado(vencedor);
+        if (segundo_colocado_arvore(sistema->arvore_candidatos)) {
+            printf("  Margem sobre o segundo colocado: %d votos\n",
+                   margem_vitoria_arvore(sistema->arvore_candidatos));
+        }
     }
     
     // 2. Encontra e exibe o CAP com maior participao
@@ -811,39 +1015,11 @@ int validar_integridade_apuracao(SistemaApuracao* sistema) {
     // Exibe cabealho da validao
     printf("\n=== VALIDAO DA APURAO ===\n");
     
-    // 1. Soma votos da rvore de candidatos
-    int total_votos_candidatos = 0;
-    // Funo auxiliar recursiva para somar votos
-    void somar_votos_candidatos(NoArvoreResultados* no) {
-        // Caso base: n nulo
-        if (!no) return;
-        // Soma os votos do n atual
-        total_votos_candidatos += no->resultado.votos;
-        // Percorre recursivamente a subrvore esquerda
-        somar_votos_candidatos(no->esquerda);
-        // Percorre recursivamente a subrvore direita
-        somar_votos_candidatos(no->direita);
-    }
-    
-    // Inicia a soma a partir da raiz da rvore
-    somar_votos_candidatos(sistema->arvore_candidatos->raiz);
+    // 1. Soma votos da rvore de candidatos (mantida em cada n, O(1))
+    int total_votos_candidatos = soma_votos_arvore(sistema->arvore_candidatos);
     
     // 2. Soma votos da rvore de CAPs
-    int total_votos_caps = 0;
-    // Funo auxiliar recursiva para somar votos
-    void somar_votos_caps(NoArvoreResultados* no) {
-        // Caso base: n nulo
-        if (!no) return;
-        // Soma os votos do n atual
-        total_votos_caps += no->resultado.votos;
-        // Percorre recursivamente a subrvore esquerda
-        somar_votos_caps(no->esquerda);
-        // Percorre recursivamente a subrvore direita
-        somar_votos_caps(no->direita);
-    }
-    
-    // Inicia a soma a partir da raiz da rvore
-    somar_votos_caps(sistema->arvore_caps->raiz);
+    int total_votos_caps = soma_votos_arvore(sistema->arvore_caps);
     
     // Exibe os totais calculados
     printf("Votos totais (candidatos): %d\n", total_votos_candidatos);
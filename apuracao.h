@@ -31,20 +31,15 @@ void destruir_arvore_resultados(ArvoreResultados* arvore) {
     // Verifica se a rvore  vlida
     if (!arvore) return;
     
-    // Funo auxiliar para destruir recursivamente
-    void destruir_recursivo(NoArvoreResultados* no) {
-        // Caso base: n nulo
-        if (!no) return;
-        // Destri recursivamente a subrvore esquerda
-        destruir_recursivo(no->esquerda);
-        // Destri recursivamente a subrvore direita
-        destruir_recursivo(no->direita);
-        // Libera a memria do n atual
+    // Ps-ordem: cada n sai do iterador depois dos filhos
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_POS_ORDEM);
+    
+    NoArvoreResultados* no;
+    // O iterador no guarda o n devolvido, ento ele pode ser liberado j
+    while ((no = proximo_no_iterador(&it)) != NULL) {
         free(no);
     }
-    
-    // Chama a funo auxiliar comeando pela raiz
-    destruir_recursivo(arvore->raiz);
     // Libera a estrutura principal da rvore
     free(arvore);
 }
@@ -149,27 +144,18 @@ ResultadoVotacao* buscar_resultado_por_nome(ArvoreResultados* arvore, const char
     // Verifica se a rvore e o nome so vlidos
     if (!arvore || !nome) return NULL;
     
-    // Funo auxiliar para busca por nome (busca linear em toda rvore)
-    ResultadoVotacao* buscar_por_nome_recursivo(NoArvoreResultados* raiz, const char* nome) {
-        // Caso base: n nulo
-        if (!raiz) return NULL;
-        
+    // Busca linear em pr-ordem (mesma ordem de visita de antes)
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
+    
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
         // Verifica se o nome do n atual  o procurado
-        if (strcmp(raiz->resultado.nome, nome) == 0) {
-            return &(raiz->resultado);
-        }
-        
-        // Busca na subrvore esquerda
-        ResultadoVotacao* encontrado = buscar_por_nome_recursivo(raiz->esquerda, nome);
-        // Se encontrou na esquerda, retorna
-        if (encontrado) return encontrado;
-        
-        // Se no encontrou na esquerda, busca na direita
-        return buscar_por_nome_recursivo(raiz->direita, nome);
+        if (strcmp(resultado->nome, nome) == 0) return resultado;
     }
     
-    // Inicia a busca a partir da raiz
-    return buscar_por_nome_recursivo(arvore->raiz, nome);
+    // Nome no encontrado
+    return NULL;
 }
 
 // Funo para remover um resultado da rvore por ID
@@ -482,21 +468,16 @@ int atualizar_percentuais_arvore(ArvoreResultados* arvore) {
     // Verifica se a rvore  vlida e tem votos
     if (!arvore || arvore->total_votos == 0) return 0;
     
-    // Funo auxiliar recursiva para atualizar percentuais
-    void atualizar_percentual_no(NoArvoreResultados* no, int total_votos) {
-        // Caso base: n nulo
-        if (!no) return;
-        
+    // Percorre todos os ns da rvore
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
+    
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
         // Calcula percentual do n atual
-        no->resultado.percentual = (float)no->resultado.votos / total_votos * 100;
-        // Atualiza subrvore esquerda
-        atualizar_percentual_no(no->esquerda, total_votos);
-        // Atualiza subrvore direita
-        atualizar_percentual_no(no->direita, total_votos);
+        resultado->percentual = (float)resultado->votos / arvore->total_votos * 100;
     }
     
-    // Inicia atualizao a partir da raiz
-    atualizar_percentual_no(arvore->raiz, arvore->total_votos);
     return 1; // Retorna sucesso
 }
 
@@ -507,16 +488,16 @@ int total_nos_arvore(ArvoreResultados* arvore) {
     // Verifica se a rvore  vlida
     if (!arvore) return 0;
     
-    // Funo auxiliar recursiva para contar ns
-    int contar_nos_recursivo(NoArvoreResultados* raiz) {
-        // Caso base: n nulo
-        if (!raiz) return 0;
-        // Conta este n + ns da esquerda + ns da direita
-        return 1 + contar_nos_recursivo(raiz->esquerda) + contar_nos_recursivo(raiz->direita);
+    // Percorre a rvore contando os ns
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
+    
+    int total = 0;
+    while (proximo_no_iterador(&it) != NULL) {
+        total++;
     }
     
-    // Inicia contagem a partir da raiz
-    return contar_nos_recursivo(arvore->raiz);
+    return total;
 }
 
 // Funo que retorna a altura da rvore
@@ -538,26 +519,20 @@ ResultadoVotacao* candidato_mais_votado_arvore(ArvoreResultados* arvore) {
     // Verifica se  rvore de candidatos
     if (!arvore || arvore->tipo_arvore != TIPO_CANDIDATO) return NULL;
     
-    NoArvoreResultados* atual = arvore->raiz;
     NoArvoreResultados* mais_votado = NULL;
     
-    // Funo auxiliar recursiva para encontrar mximo
-    void encontrar_maximo_recursivo(NoArvoreResultados* no) {
-        // Caso base: n nulo
-        if (!no) return;
-        
+    // Percorre em pr-ordem (em empate fica o primeiro, como antes)
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
+    
+    NoArvoreResultados* no;
+    while ((no = proximo_no_iterador(&it)) != NULL) {
         // Atualiza mais_votado se necessrio
         if (!mais_votado || no->resultado.votos > mais_votado->resultado.votos) {
             mais_votado = no;
         }
-        
-        // Busca nas subrvores
-        encontrar_maximo_recursivo(no->esquerda);
-        encontrar_maximo_recursivo(no->direita);
     }
     
-    // Inicia busca a partir da raiz
-    encontrar_maximo_recursivo(atual);
     // Retorna resultado (ou NULL se rvore vazia)
     return mais_votado ? &(mais_votado->resultado) : NULL;
 }
@@ -567,26 +542,20 @@ ResultadoVotacao* candidato_menos_votado_arvore(ArvoreResultados* arvore) {
     // Verifica se  rvore de candidatos
     if (!arvore || arvore->tipo_arvore != TIPO_CANDIDATO) return NULL;
     
-    NoArvoreResultados* atual = arvore->raiz;
     NoArvoreResultados* menos_votado = NULL;
     
-    // Funo auxiliar recursiva para encontrar mnimo
-    void encontrar_minimo_recursivo(NoArvoreResultados* no) {
-        // Caso base: n nulo
-        if (!no) return;
-        
+    // Percorre em pr-ordem (em empate fica o primeiro, como antes)
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
+    
+    NoArvoreResultados* no;
+    while ((no = proximo_no_iterador(&it)) != NULL) {
         // Atualiza menos_votado se necessrio
         if (!menos_votado || no->resultado.votos < menos_votado->resultado.votos) {
             menos_votado = no;
         }
-        
-        // Busca nas subrvores
-        encontrar_minimo_recursivo(no->esquerda);
-        encontrar_minimo_recursivo(no->direita);
     }
     
-    // Inicia busca a partir da raiz
-    encontrar_minimo_recursivo(atual);
     // Retorna resultado (ou NULL se rvore vazia)
     return menos_votado ? &(menos_votado->resultado) : NULL;
 }
@@ -616,25 +585,17 @@ void candidatos_acima_de_limite(ArvoreResultados* arvore, int limite_votos) {
     
     printf("\n=== CANDIDATOS COM MAIS DE %d VOTOS ===\n", limite_votos);
     
-    // Funo auxiliar recursiva para verificar limite
-    void verificar_limite_recursivo(NoArvoreResultados* no, int limite) {
-        // Caso base: n nulo
-        if (!no) return;
-        
-        // Verifica subrvore esquerda
-        verificar_limite_recursivo(no->esquerda, limite);
-        
+    // Percorre em ordem de ID
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_EM_ORDEM);
+    
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
         // Se votos acima do limite, exibe resultado
-        if (no->resultado.votos > limite) {
-            exibir_resultado_formatado(&no->resultado);
+        if (resultado->votos > limite_votos) {
+            exibir_resultado_formatado(resultado);
         }
-        
-        // Verifica subrvore direita
-        verificar_limite_recursivo(no->direita, limite);
     }
-    
-    // Inicia verificao a partir da raiz
-    verificar_limite_recursivo(arvore->raiz, limite_votos);
 }
 
 // Funo que lista CAPs com votos acima de um limite
@@ -754,14 +715,15 @@ int exportar_resultados_csv(ArvoreResultados* arvore, const char* filename) {
     // Escreve cabealho CSV
     fprintf(arquivo, "Tipo;ID;Nome;Votos;Percentual\n");
     
-    // Funo auxiliar recursiva para exportar ns
-    void exportar_no_csv(NoArvoreResultados* no) {
-        // Caso base: n nulo
-        if (!no) return;
-        
+    // Exporta em pr-ordem (mesma ordem de linhas de antes)
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
+    
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
         // Converte tipo para string
         const char* tipo_str;
-        switch (no->resultado.tipo) {
+        switch (resultado->tipo) {
             case TIPO_CANDIDATO: tipo_str = "CANDIDATO"; break;
             case TIPO_CAP: tipo_str = "CAP"; break;
             case TIPO_REGIAO: tipo_str = "REGIAO"; break;
@@ -771,18 +733,12 @@ int exportar_resultados_csv(ArvoreResultados* arvore, const char* filename) {
         // Escreve linha CSV
         fprintf(arquivo, "%s;%d;%s;%d;%.2f\n",
                 tipo_str,
-                no->resultado.id,
-                no->resultado.nome,
-                no->resultado.votos,
-                no->resultado.percentual);
-        
-        // Exporta subrvores
-        exportar_no_csv(no->esquerda);
-        exportar_no_csv(no->direita);
+                resultado->id,
+                resultado->nome,
+                resultado->votos,
+                resultado->percentual);
     }
     
-    // Inicia exportao da raiz
-    exportar_no_csv(arvore->raiz);
     fclose(arquivo);
     
     printf("Resultados exportados para %s\n", filename);
@@ -816,33 +772,25 @@ int exportar_resultados_json(ArvoreResultados* arvore, const char* filename) {
     
     int primeiro = 1; // Flag para controlar vrgulas
     
-    // Funo auxiliar recursiva para exportar em JSON
-    void exportar_no_json(NoArvoreResultados* no) {
-        // Caso base: n nulo
-        if (!no) return;
-        
-        // Exporta subrvore esquerda
-        exportar_no_json(no->esquerda);
-        
+    // Exporta em ordem de ID
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_EM_ORDEM);
+    
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
         // Adiciona vrgula se no for o primeiro elemento
         if (!primeiro) fprintf(arquivo, ",\n");
         primeiro = 0;
         
         // Escreve objeto JSON do n
         fprintf(arquivo, "    {\n");
-        fprintf(arquivo, "      \"id\": %d,\n", no->resultado.id);
-        fprintf(arquivo, "      \"nome\": \"%s\",\n", no->resultado.nome);
-        fprintf(arquivo, "      \"votos\": %d,\n", no->resultado.votos);
-        fprintf(arquivo, "      \"percentual\": %.2f\n", no->resultado.percentual);
+        fprintf(arquivo, "      \"id\": %d,\n", resultado->id);
+        fprintf(arquivo, "      \"nome\": \"%s\",\n", resultado->nome);
+        fprintf(arquivo, "      \"votos\": %d,\n", resultado->votos);
+        fprintf(arquivo, "      \"percentual\": %.2f\n", resultado->percentual);
         fprintf(arquivo, "    }");
-        
-        // Exporta subrvore direita
-        exportar_no_json(no->direita);
     }
     
-    // Inicia exportao da raiz
-    exportar_no_json(arvore->raiz);
-    
     // Fecha estruturas JSON
     fprintf(arquivo, "\n  ]\n");
     fprintf(arquivo, "}\n");
@@ -860,20 +808,16 @@ void ordenar_resultados_decrescente(ArvoreResultados* arvore,
     // Verifica parmetros
     if (!arvore || !array || !indice) return;
     
-    // Funo auxiliar para coletar resultados em array
-    void coletar_resultados(NoArvoreResultados* no) {
-        // Caso base: n nulo
-        if (!no) return;
-        
-        // Coleta em ordem (para manter array inicialmente ordenado por ID)
-        coletar_resultados(no->esquerda);
-        array[(*indice)++] = &(no->resultado);
-        coletar_resultados(no->direita);
-    }
+    // Coleta em ordem (para manter array inicialmente ordenado por ID)
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_EM_ORDEM);
     
     // Inicia coleta
     *indice = 0;
-    coletar_resultados(arvore->raiz);
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
+        array[(*indice)++] = resultado;
+    }
     
     // Ordenao por bolha decrescente (por votos)
     for (int i = 0; i < *indice - 1; i++) {
@@ -903,18 +847,15 @@ ResultadoVotacao** obter_resultados_ordenados(ArvoreResultados* arvore, int orde
     
     int indice = 0;
     
-    // Funo auxiliar para coletar resultados em array
-    void coletar_em_array(NoArvoreResultados* no) {
-        // Caso base: n nulo
-        if (!no) return;
-        // Coleta em ordem (esquerda, raiz, direita)
-        coletar_em_array(no->esquerda);
-        array[indice++] = &(no->resultado);
-        coletar_em_array(no->direita);
-    }
+    // Coleta em ordem (esquerda, raiz, direita)
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_EM_ORDEM);
     
     // Coleta resultados
-    coletar_em_array(arvore->raiz);
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
+        array[indice++] = resultado;
+    }
     
     // Ordena se necessrio
     if (ordem == 1) { // Decrescente
@@ -0,0 +1,406 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "apuracao_paralela.h"
+#include "pilhas.h"
+
+// ================= IMPLEMENTAO MAPA DE NMEROS =================
+
+// Par nmero -> posio, usado quando os nmeros so esparsos demais
+typedef struct ParNumero {
+    int numero;
+    int posicao;
+} ParNumero;
+
+// Traduz nmero de candidato (ou ID de CAP) para a posio na lista: tabela
+// direta quando a faixa de nmeros  pequena, busca binria caso contrrio
+typedef struct MapaNumeros {
+    int* tabela;                // numero - menor -> posio (-1 = ausente)
+    int menor;                  // Menor nmero da tabela
+    unsigned long long faixa;   // Tamanho da tabela
+    ParNumero* pares;           // Sem tabela: pares ordenados por nmero
+    int quantidade;             // Nmero de pares
+} MapaNumeros;
+
+static int comparar_pares(const void* a, const void* b) {
+    const ParNumero* x = (const ParNumero*)a;
+    const ParNumero* y = (const ParNumero*)b;
+    if (x->numero != y->numero) return x->numero < y->numero ? -1 : 1;
+    return x->posicao < y->posicao ? -1 : (x->posicao > y->posicao);
+}
+
+// Nmero repetido fica com a primeira posio, como na busca linear da lista
+static int montar_mapa(MapaNumeros* mapa, const int* numeros, int quantidade) {
+    memset(mapa, 0, sizeof(MapaNumeros));
+    if (quantidade <= 0) return 1;
+
+    int menor = numeros[0], maior = numeros[0];
+    for (int i = 1; i < quantidade; i++) {
+        if (numeros[i] < menor) menor = numeros[i];
+        if (numeros[i] > maior) maior = numeros[i];
+    }
+
+    unsigned long long faixa = (unsigned long long)((long long)maior - menor) + 1;
+    if (faixa <= LIMITE_TABELA_DIRETA) {
+        mapa->tabela = (int*)malloc(faixa * sizeof(int));
+        if (!mapa->tabela) return 0;
+        memset(mapa->tabela, 0xff, faixa * sizeof(int));
+        for (int i = quantidade - 1; i >= 0; i--) {
+            mapa->tabela[numeros[i] - menor] = i;
+        }
+        mapa->menor = menor;
+        mapa->faixa = faixa;
+        return 1;
+    }
+
+    mapa->pares = (ParNumero*)malloc(quantidade * sizeof(ParNumero));
+    if (!mapa->pares) return 0;
+    for (int i = 0; i < quantidade; i++) {
+        mapa->pares[i].numero = numeros[i];
+        mapa->pares[i].posicao = i;
+    }
+    qsort(mapa->pares, quantidade, sizeof(ParNumero), comparar_pares);
+
+    // Fica s o primeiro par de cada nmero (o de menor posio)
+    int unicos = 1;
+    for (int i = 1; i < quantidade; i++) {
+        if (mapa->pares[i].numero != mapa->pares[unicos - 1].numero) mapa->pares[unicos++] = mapa->pares[i];
+    }
+    mapa->quantidade = unicos;
+    return 1;
+}
+
+static void liberar_mapa(MapaNumeros* mapa) {
+    free(mapa->tabela);
+    free(mapa->pares);
+    memset(mapa, 0, sizeof(MapaNumeros));
+}
+
+static int posicao_numero(const MapaNumeros* mapa, int numero) {
+    if (mapa->tabela) {
+        unsigned long long deslocamento = (unsigned long long)((long long)numero - mapa->menor);
+        return deslocamento < mapa->faixa ? mapa->tabela[deslocamento] : -1;
+    }
+
+    if (mapa->quantidade == 0) return -1;
+
+    // ltimo par com nmero <= o procurado; sem desvios dependentes do
+    // dado, que com votos aleatrios erram metade das previses
+    const ParNumero* base = mapa->pares;
+    int restantes = mapa->quantidade;
+    while (restantes > 1) {
+        int metade = restantes / 2;
+        base = base[metade].numero <= numero ? base + metade : base;
+        restantes -= metade;
+    }
+    return base->numero == numero ? base->posicao : -1;
+}
+
+// ================= IMPLEMENTAO CONTAGEM PARALELA =================
+
+// Unidade de trabalho: um trecho do histrico de uma urna ou um arquivo
+typedef struct TarefaContagem {
+    PilhaVotos* pilha;          // Histrico da urna (NULL = tarefa de arquivo)
+    const char* arquivo;        // Arquivo de votos
+    int inicio;                 // Trecho [inicio, fim) do histrico
+    int fim;
+} TarefaContagem;
+
+struct ContextoContagem;
+
+// Vetores privados de uma thread; nenhuma outra thread escreve neles
+// at a reduo
+typedef struct ParcialContagem {
+    int* votos_candidatos;
+    int* votos_caps;
+    long long votos_contados;
+    long long votos_ignorados;
+    int falhou;                 // Algum arquivo no pde ser lido
+    int indice;                 // Posio da thread na rvore de reduo
+    int em_thread;              // 1 = rodando numa thread prpria (precisa de join)
+    pthread_t thread;
+    struct ContextoContagem* contexto;
+} ParcialContagem;
+
+typedef struct ContextoContagem {
+    TarefaContagem* tarefas;
+    int num_tarefas;
+    int proxima_tarefa;         // Prxima tarefa livre (incremento atmico)
+    MapaNumeros mapa_candidatos;
+    MapaNumeros mapa_caps;
+    int num_candidatos;
+    int num_caps;               // 0 quando a contagem no separa por CAP
+    ParcialContagem* parciais;
+    int num_threads;
+} ContextoContagem;
+
+int threads_disponiveis() {
+    long processadores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (processadores < 1) return 1;
+    if (processadores > MAX_THREADS_APURACAO) return MAX_THREADS_APURACAO;
+    return (int)processadores;
+}
+
+static void contar_trecho_urna(ParcialContagem* parcial, TarefaContagem* tarefa) {
+    ContextoContagem* contexto = parcial->contexto;
+    int* votos = parcial->votos_candidatos;
+    long long contados = 0, ignorados = 0;
+
+    for (int i = tarefa->inicio; i < tarefa->fim; i++) {
+        Voto* voto = voto_na_posicao(tarefa->pilha, i);
+        int posicao = posicao_numero(&contexto->mapa_candidatos, voto->numero_candidato);
+        if (posicao < 0) {
+            ignorados++;
+            continue;
+        }
+        votos[posicao]++;
+        contados++;
+    }
+
+    parcial->votos_contados += contados;
+    parcial->votos_ignorados += ignorados;
+}
+
+static void contar_voto_arquivo(Voto* voto, void* argumento) {
+    ParcialContagem* parcial = (ParcialContagem*)argumento;
+    ContextoContagem* contexto = parcial->contexto;
+
+    int posicao = posicao_numero(&contexto->mapa_candidatos, voto->numero_candidato);
+    if (posicao < 0) {
+        parcial->votos_ignorados++;
+        return;
+    }
+    parcial->votos_candidatos[posicao]++;
+    parcial->votos_contados++;
+
+    int posicao_cap = posicao_numero(&contexto->mapa_caps, voto->id_cap);
+    if (posicao_cap >= 0) parcial->votos_caps[posicao_cap]++;
+}
+
+static void somar_parcial(ParcialContagem* destino, ParcialContagem* origem,
+                          ContextoContagem* contexto) {
+    for (int i = 0; i < contexto->num_candidatos; i++) {
+        destino->votos_candidatos[i] += origem->votos_candidatos[i];
+    }
+    for (int i = 0; i < contexto->num_caps; i++) {
+        destino->votos_caps[i] += origem->votos_caps[i];
+    }
+    destino->votos_contados += origem->votos_contados;
+    destino->votos_ignorados += origem->votos_ignorados;
+    destino->falhou |= origem->falhou;
+}
+
+// Fase map: pega tarefas at acabarem. Fase reduce: a thread i soma as
+// parciais i+1, i+2, i+4, ... enquanto i for mltiplo do dobro do passo; a
+// thread 0 termina com o total em log2(threads) rodadas
+static void* executar_contagem(void* argumento) {
+    ParcialContagem* parcial = (ParcialContagem*)argumento;
+    ContextoContagem* contexto = parcial->contexto;
+
+    for (;;) {
+        int indice = __atomic_fetch_add(&contexto->proxima_tarefa, 1, __ATOMIC_RELAXED);
+        if (indice >= contexto->num_tarefas) break;
+
+        TarefaContagem* tarefa = &contexto->tarefas[indice];
+        if (tarefa->pilha) {
+            contar_trecho_urna(parcial, tarefa);
+        } else if (percorrer_arquivo_votos(tarefa->arquivo, contar_voto_arquivo, parcial) < 0) {
+            parcial->falhou = 1;
+        }
+    }
+
+    for (int passo = 1; passo < contexto->num_threads; passo *= 2) {
+        if (parcial->indice % (2 * passo) != 0) break;
+        int filho = parcial->indice + passo;
+        if (filho >= contexto->num_threads) break;
+
+        // O filho s  lido depois de terminar (join) ou de ter rodado antes
+        ParcialContagem* outro = &contexto->parciais[filho];
+        if (outro->em_thread) pthread_join(outro->thread, NULL);
+        somar_parcial(parcial, outro, contexto);
+    }
+    return NULL;
+}
+
+static int lista_numeros_candidatos(MapaNumeros* mapa, ListaCandidatos* candidatos) {
+    int* numeros = (int*)malloc((candidatos->tamanho + 1) * sizeof(int));
+    if (!numeros) return 0;
+    for (int i = 0; i < candidatos->tamanho; i++) numeros[i] = candidatos->candidatos[i].numero;
+    int ok = montar_mapa(mapa, numeros, candidatos->tamanho);
+    free(numeros);
+    return ok;
+}
+
+static int lista_ids_caps(MapaNumeros* mapa, ListaCAPs* caps) {
+    int* ids = (int*)malloc((caps->tamanho + 1) * sizeof(int));
+    if (!ids) return 0;
+    for (int i = 0; i < caps->tamanho; i++) ids[i] = caps->caps[i].id;
+    int ok = montar_mapa(mapa, ids, caps->tamanho);
+    free(ids);
+    return ok;
+}
+
+// Distribui as tarefas do contexto entre as threads e entrega o total
+static int executar_contagem_paralela(ContextoContagem* contexto, int num_threads,
+                                      ContagemVotos* contagem) {
+    if (num_threads <= 0) num_threads = threads_disponiveis();
+    if (num_threads > MAX_THREADS_APURACAO) num_threads = MAX_THREADS_APURACAO;
+    // Thread sem tarefa s atrasaria a reduo
+    if (num_threads > contexto->num_tarefas) num_threads = contexto->num_tarefas > 0 ? contexto->num_tarefas : 1;
+
+    ParcialContagem* parciais = (ParcialContagem*)calloc(num_threads, sizeof(ParcialContagem));
+    if (!parciais) return 0;
+
+    // Um bloco por thread: candidatos seguidos dos CAPs
+    size_t por_thread = (size_t)contexto->num_candidatos + contexto->num_caps + 1;
+    for (int i = 0; i < num_threads; i++) {
+        parciais[i].votos_candidatos = (int*)calloc(por_thread, sizeof(int));
+        if (!parciais[i].votos_candidatos) {
+            for (int j = 0; j < i; j++) free(parciais[j].votos_candidatos);
+            free(parciais);
+            return 0;
+        }
+        parciais[i].votos_caps = parciais[i].votos_candidatos + contexto->num_candidatos;
+        parciais[i].indice = i;
+        parciais[i].contexto = contexto;
+    }
+    contexto->parciais = parciais;
+    contexto->num_threads = num_threads;
+    contexto->proxima_tarefa = 0;
+
+    // Cria da ltima para a primeira: quando uma thread comea, as que ela
+    // vai esperar na reduo j existem
+    int i = num_threads - 1;
+    for (; i >= 1; i--) {
+        if (pthread_create(&parciais[i].thread, NULL, executar_contagem, &parciais[i]) != 0) break;
+        parciais[i].em_thread = 1;
+    }
+    // Sem threads suficientes, as parciais restantes rodam aqui mesmo, na
+    // mesma ordem
+    for (; i >= 1; i--) executar_contagem(&parciais[i]);
+    executar_contagem(&parciais[0]);
+
+    for (int j = 1; j < num_threads; j++) free(parciais[j].votos_candidatos);
+
+    contagem->votos_candidatos = parciais[0].votos_candidatos;
+    contagem->votos_caps = contexto->num_caps > 0 ? parciais[0].votos_caps : NULL;
+    contagem->num_candidatos = contexto->num_candidatos;
+    contagem->num_caps = contexto->num_caps;
+    contagem->votos_contados = parciais[0].votos_contados;
+    contagem->votos_ignorados = parciais[0].votos_ignorados;
+    int falhou = parciais[0].falhou;
+    free(parciais);
+
+    if (falhou) {
+        liberar_contagem_votos(contagem);
+        return 0;
+    }
+    return 1;
+}
+
+// Sem caps, a contagem fica s nos candidatos: nem mapa nem vetores de CAPs
+static int preparar_contexto(ContextoContagem* contexto, ListaCandidatos* candidatos,
+                             ListaCAPs* caps) {
+    memset(contexto, 0, sizeof(ContextoContagem));
+    contexto->num_candidatos = candidatos->tamanho;
+    if (!lista_numeros_candidatos(&contexto->mapa_candidatos, candidatos)) return 0;
+    if (!caps) return 1;
+    contexto->num_caps = caps->tamanho;
+    if (!lista_ids_caps(&contexto->mapa_caps, caps)) {
+        liberar_mapa(&contexto->mapa_candidatos);
+        return 0;
+    }
+    return 1;
+}
+
+static void liberar_contexto(ContextoContagem* contexto) {
+    liberar_mapa(&contexto->mapa_candidatos);
+    liberar_mapa(&contexto->mapa_caps);
+    free(contexto->tarefas);
+}
+
+int contar_votos_urnas_paralelo(ListaCandidatos* candidatos, ListaCAPs* caps,
+                                int num_threads, ContagemVotos* contagem) {
+    if (!candidatos || !caps || !contagem) return 0;
+    memset(contagem, 0, sizeof(ContagemVotos));
+
+    // O CAP da urna no  somado: a apurao conta o CAP pelos eleitores
+    // atendidos, que incluem quem foi chamado e no chegou a votar
+    ContextoContagem contexto;
+    if (!preparar_contexto(&contexto, candidatos, NULL)) return 0;
+
+    // Quebra cada histrico em trechos de VOTOS_POR_TAREFA votos, para que
+    // uma urna cheia no fique toda com uma s thread
+    int num_tarefas = 0;
+    for (int i = 0; i < caps->tamanho; i++) {
+        CAP* cap = &caps->caps[i];
+        if (!cap->urnas) continue;
+        for (int j = 0; j < cap->num_urnas; j++) {
+            Urna* urna = cap->urnas[j];
+            if (!urna || !urna->historico_votos) continue;
+            int tamanho = tamanho_pilha_votos(urna->historico_votos);
+            num_tarefas += (tamanho + VOTOS_POR_TAREFA - 1) / VOTOS_POR_TAREFA;
+        }
+    }
+
+    contexto.tarefas = (TarefaContagem*)malloc((num_tarefas + 1) * sizeof(TarefaContagem));
+    if (!contexto.tarefas) {
+        liberar_contexto(&contexto);
+        return 0;
+    }
+
+    for (int i = 0; i < caps->tamanho; i++) {
+        CAP* cap = &caps->caps[i];
+        if (!cap->urnas) continue;
+        for (int j = 0; j < cap->num_urnas; j++) {
+            Urna* urna = cap->urnas[j];
+            if (!urna || !urna->historico_votos) continue;
+            int tamanho = tamanho_pilha_votos(urna->historico_votos);
+            for (int inicio = 0; inicio < tamanho; inicio += VOTOS_POR_TAREFA) {
+                TarefaContagem* tarefa = &contexto.tarefas[contexto.num_tarefas++];
+                tarefa->pilha = urna->historico_votos;
+                tarefa->arquivo = NULL;
+                tarefa->inicio = inicio;
+                tarefa->fim = tamanho - inicio > VOTOS_POR_TAREFA ? inicio + VOTOS_POR_TAREFA : tamanho;
+            }
+        }
+    }
+
+    int ok = executar_contagem_paralela(&contexto, num_threads, contagem);
+    liberar_contexto(&contexto);
+    return ok;
+}
+
+int contar_arquivos_votos_paralelo(const char* const* arquivos, int num_arquivos,
+                                   ListaCandidatos* candidatos, ListaCAPs* caps,
+                                   int num_threads, ContagemVotos* contagem) {
+    if (!arquivos || num_arquivos < 0 || !candidatos || !caps || !contagem) return 0;
+    memset(contagem, 0, sizeof(ContagemVotos));
+
+    ContextoContagem contexto;
+    if (!preparar_contexto(&contexto, candidatos, caps)) return 0;
+
+    contexto.tarefas = (TarefaContagem*)calloc(num_arquivos + 1, sizeof(TarefaContagem));
+    if (!contexto.tarefas) {
+        liberar_contexto(&contexto);
+        return 0;
+    }
+    for (int i = 0; i < num_arquivos; i++) {
+        contexto.tarefas[i].arquivo = arquivos[i];
+    }
+    contexto.num_tarefas = num_arquivos;
+
+    int ok = executar_contagem_paralela(&contexto, num_threads, contagem);
+    liberar_contexto(&contexto);
+    return ok;
+}
+
+void liberar_contagem_votos(ContagemVotos* contagem) {
+    if (!contagem) return;
+    // votos_caps mora no mesmo bloco de votos_candidatos
+    free(contagem->votos_candidatos);
+    memset(contagem, 0, sizeof(ContagemVotos));
+}
@@ -0,0 +1,41 @@
+#ifndef APURACAO_PARALELA_H
+#define APURACAO_PARALELA_H
+
+#include "estruturas.h"
+
+// ================= APURAO PARALELA (MAP-REDUCE) =================
+
+#define MAX_THREADS_APURACAO 64        // Limite de threads de contagem
+#define VOTOS_POR_TAREFA 4096          // Votos de uma urna por unidade de trabalho
+#define LIMITE_TABELA_DIRETA (1 << 20) // Faixa mxima de nmeros indexada direto
+
+// Totais de uma contagem; as posies seguem as listas de candidatos e CAPs
+typedef struct ContagemVotos {
+    int* votos_candidatos;      // Votos por posio em ListaCandidatos
+    int* votos_caps;            // Votos por posio em ListaCAPs (s arquivos)
+    int num_candidatos;         // Tamanho de votos_candidatos
+    int num_caps;               // Tamanho de votos_caps (0 nas urnas)
+    long long votos_contados;   // Votos atribudos a um candidato cadastrado
+    long long votos_ignorados;  // Votos para nmeros fora do cadastro
+} ContagemVotos;
+
+// Prottipo da funo que informa quantos processadores esto disponveis
+int threads_disponiveis();
+
+// Prottipo da funo que conta os histricos de todas as urnas dos CAPs: cada
+// thread soma trechos de urnas em vetores prprios e os vetores so somados
+// em rvore ao final. num_threads <= 0 usa threads_disponiveis(). No h
+// total por CAP (num_caps = 0, votos_caps = NULL): a apurao conta o CAP
+// pelos eleitores atendidos. Retorna 1 em sucesso e 0 sem memria
+int contar_votos_urnas_paralelo(ListaCandidatos* candidatos, ListaCAPs* caps,
+                                int num_threads, ContagemVotos* contagem);
+// Prottipo da funo que faz a mesma contagem sobre arquivos de votos (um
+// arquivo por unidade de trabalho); aqui o CAP vem do id_cap de cada voto.
+// Arquivo ilegvel faz a contagem inteira falhar (retorna 0)
+int contar_arquivos_votos_paralelo(const char* const* arquivos, int num_arquivos,
+                                   ListaCandidatos* candidatos, ListaCAPs* caps,
+                                   int num_threads, ContagemVotos* contagem);
+// Prottipo da funo que libera os vetores de uma contagem
+void liberar_contagem_votos(ContagemVotos* contagem);
+
+#endif
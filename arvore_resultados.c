@@ -2,17 +2,57 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <limits.h>
 #include "arvore_resultados.h"
+#include "escritor_saida.h"
 
 // Funo auxiliar para mximo (APENAS ESTA!)
 static int max(int a, int b) {
     return (a > b) ? a : b;
 }
 
+// ndice de ranking (implementado no fim do arquivo)
+static void indexar_ranking(ArvoreResultados* arvore, NoRanking* no, ResultadoVotacao* resultado);
+static NoRanking* desindexar_ranking(ArvoreResultados* arvore, ResultadoVotacao* resultado);
+static void reposicionar_ranking(ArvoreResultados* arvore, ResultadoVotacao* resultado, int votos_anteriores);
+static void atualizar_extremos(ArvoreResultados* arvore);
+static void liberar_no_ranking(ArvoreResultados* arvore, NoRanking* no);
+static void destruir_ranking(ArvoreResultados* arvore, NoRanking* no);
+
+// ndice de nomes (implementado no fim do arquivo)
+static void indexar_nome(ArvoreResultados* arvore, ResultadoVotacao* resultado);
+static void desindexar_nome(ArvoreResultados* arvore, ResultadoVotacao* resultado);
+static ResultadoVotacao* buscar_indice_nomes(IndiceNomes* indice, const char* nome);
+
+static int tamanho_subarvore(NoArvoreResultados* no) {
+    return no ? no->tamanho : 0;
+}
+
+static int soma_votos_subarvore(NoArvoreResultados* no) {
+    return no ? no->soma_votos : 0;
+}
+
+// Recalcula altura, tamanho e soma de votos a partir dos filhos
+static void atualizar_no_resultado(NoArvoreResultados* no) {
+    no->altura = 1 + max(altura_no(no->esquerda), altura_no(no->direita));
+    no->tamanho = 1 + tamanho_subarvore(no->esquerda) + tamanho_subarvore(no->direita);
+    no->soma_votos = no->resultado.votos + soma_votos_subarvore(no->esquerda) +
+                     soma_votos_subarvore(no->direita);
+}
+
 ArvoreResultados* criar_arvore_resultados(TipoNoArvore tipo) {
     ArvoreResultados* arvore = (ArvoreResultados*)malloc(sizeof(ArvoreResultados));
     if (arvore) {
         arvore->raiz = NULL;
+        arvore->ranking = NULL;
+        arvore->lider = NULL;
+        arvore->vice = NULL;
+        arvore->ultimo_colocado = NULL;
+        arvore->indice_nomes = NULL;
+        arvore->bloco_nos = NULL;
+        arvore->bloco_ranking = NULL;
+        arvore->nos_no_bloco = 0;
+        arvore->percentuais_pendentes = 0;
         arvore->total_votos = 0;
         arvore->total_eleitores = 0;
         arvore->participacao = 0.0;
@@ -24,15 +64,18 @@ ArvoreResultados* criar_arvore_resultados(TipoNoArvore tipo) {
 void destruir_arvore_resultados(ArvoreResultados* arvore) {
     if (!arvore) return;
     
-    // Funo auxiliar para destruir recursivamente
-    void destruir_recursivo(NoArvoreResultados* no) {
-        if (!no) return;
-        destruir_recursivo(no->esquerda);
-        destruir_recursivo(no->direita);
-        free(no);
+    // Na pr-ordem o n sai com os filhos j empilhados, ento pode ser liberado
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
+    
+    NoArvoreResultados* no;
+    while ((no = proximo_no_iterador(&it)) != NULL) {
+        destruir_no_resultado(no);
     }
     
-    destruir_recursivo(arvore->raiz);
+    destruir_ranking(arvore, arvore->ranking);
+    desativar_indice_nomes(arvore);
+    free(arvore->bloco_nos);
     free(arvore);
 }
 
@@ -43,12 +86,16 @@ NoArvoreResultados* criar_no_resultado(ResultadoVotacao resultado) {
         novo_no->esquerda = NULL;
         novo_no->direita = NULL;
         novo_no->altura = 1; // Altura inicial
+        novo_no->tamanho = 1;
+        novo_no->soma_votos = resultado.votos;
+        novo_no->em_bloco = 0;
     }
     return novo_no;
 }
 
+// Ns da carga em lote ficam no bloco at a rvore ser destruda
 void destruir_no_resultado(NoArvoreResultados* no) {
-    if (no) free(no);
+    if (no && !no->em_bloco) free(no);
 }
 
 int inserir_resultado_arvore(ArvoreResultados* arvore, ResultadoVotacao resultado) {
@@ -57,10 +104,25 @@ int inserir_resultado_arvore(ArvoreResultados* arvore, ResultadoVotacao resultad
     NoArvoreResultados* novo_no = criar_no_resultado(resultado);
     if (!novo_no) return 0;
     
+    // ID repetido soma os votos no n existente, que depois  reposicionado
+    // no ranking a partir da chave antiga
+    ResultadoVotacao* existente = buscar_resultado_por_id(arvore, resultado.id);
+    int votos_anteriores = existente ? existente->votos : 0;
+    
     arvore->raiz = inserir_no_recursivo(arvore->raiz, novo_no);
     
+    if (existente) {
+        reposicionar_ranking(arvore, existente, votos_anteriores);
+    } else {
+        // N novo (no fundido com um existente) entra tambm no ndice de nomes
+        indexar_ranking(arvore, NULL, &novo_no->resultado);
+        indexar_nome(arvore, &novo_no->resultado);
+        atualizar_extremos(arvore);
+    }
+    
     // Atualizar estatsticas da rvore
     arvore->total_votos += resultado.votos;
+    arvore->percentuais_pendentes = 1;
     
     return 1;
 }
@@ -76,12 +138,13 @@ NoArvoreResultados* inserir_no_recursivo(NoArvoreResultados* raiz, NoArvoreResul
     } else {
         // ID j existe, atualizar votos
         raiz->resultado.votos += novo_no->resultado.votos;
+        raiz->soma_votos += novo_no->resultado.votos;
         free(novo_no);
         return raiz;
     }
     
-    // Atualizar altura
-    raiz->altura = 1 + max(altura_no(raiz->esquerda), altura_no(raiz->direita));
+    // Atualizar altura, tamanho e soma de votos
+    atualizar_no_resultado(raiz);
     
     // Balancear a rvore (AVL)
     return balancear_no(raiz);
@@ -108,31 +171,52 @@ NoArvoreResultados* buscar_no_recursivo(NoArvoreResultados* raiz, int id) {
 
 ResultadoVotacao* buscar_resultado_por_nome(ArvoreResultados* arvore, const char* nome) {
     if (!arvore || !nome) return NULL;
+    atualizar_percentuais_arvore(arvore);
     
-    // Funo auxiliar para busca por nome (busca linear)
-    ResultadoVotacao* buscar_por_nome_recursivo(NoArvoreResultados* raiz, const char* nome) {
-        if (!raiz) return NULL;
-        
-        if (strcmp(raiz->resultado.nome, nome) == 0) {
-            return &(raiz->resultado);
-        }
-        
-        ResultadoVotacao* encontrado = buscar_por_nome_recursivo(raiz->esquerda, nome);
-        if (encontrado) return encontrado;
-        
-        return buscar_por_nome_recursivo(raiz->direita, nome);
+    if (arvore->indice_nomes) return buscar_indice_nomes(arvore->indice_nomes, nome);
+    
+    // Sem ndice: busca linear em pr-ordem
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
+    
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
+        if (strcmp(resultado->nome, nome) == 0) return resultado;
     }
     
-    return buscar_por_nome_recursivo(arvore->raiz, nome);
+    return NULL;
 }
 
 int remover_resultado_arvore(ArvoreResultados* arvore, int id) {
     if (!arvore) return 0;
     
+    ResultadoVotacao* resultado = buscar_resultado_por_id(arvore, id);
+    if (resultado) {
+        liberar_no_ranking(arvore, desindexar_ranking(arvore, resultado));
+        atualizar_extremos(arvore);
+        desindexar_nome(arvore, resultado);
+        arvore->total_votos -= resultado->votos;
+    }
+    
     arvore->raiz = remover_no_recursivo(arvore->raiz, id);
+    arvore->percentuais_pendentes = 1;
     return 1;
 }
 
+// Tira o menor n da subrvore sem liber-lo e devolve a subrvore rebalanceada
+static NoArvoreResultados* desligar_minimo(NoArvoreResultados* raiz, NoArvoreResultados** minimo) {
+    if (!raiz->esquerda) {
+        *minimo = raiz;
+        return raiz->direita;
+    }
+    
+    raiz->esquerda = desligar_minimo(raiz->esquerda, minimo);
+    atualizar_no_resultado(raiz);
+    return balancear_no(raiz);
+}
+
+// Os ns so religados, nunca copiados: um ResultadoVotacao fica no mesmo
+// endereo enquanto estiver na rvore, o que permite ndices por ponteiro
 NoArvoreResultados* remover_no_recursivo(NoArvoreResultados* raiz, int id) {
     if (!raiz) return NULL;
     
@@ -143,31 +227,23 @@ NoArvoreResultados* remover_no_recursivo(NoArvoreResultados* raiz, int id) {
     } else {
         // N encontrado
         if (!raiz->esquerda || !raiz->direita) {
-            // Um ou nenhum filho
-            NoArvoreResultados* temp = raiz->esquerda ? raiz->esquerda : raiz->direita;
-            
-            if (!temp) {
-                // Nenhum filho
-                temp = raiz;
-                raiz = NULL;
-            } else {
-                // Um filho
-                *raiz = *temp;
-            }
-            
-            free(temp);
-        } else {
-            // Dois filhos
-            NoArvoreResultados* temp = encontrar_minimo(raiz->direita);
-            raiz->resultado = temp->resultado;
-            raiz->direita = remover_no_recursivo(raiz->direita, temp->resultado.id);
+            // Um ou nenhum filho: o filho (j balanceado) sobe no lugar
+            NoArvoreResultados* filho = raiz->esquerda ? raiz->esquerda : raiz->direita;
+            destruir_no_resultado(raiz);
+            return filho;
         }
+        
+        // Dois filhos: o sucessor  desligado e assume a posio do n
+        NoArvoreResultados* sucessor = NULL;
+        NoArvoreResultados* direita = desligar_minimo(raiz->direita, &sucessor);
+        sucessor->esquerda = raiz->esquerda;
+        sucessor->direita = direita;
+        destruir_no_resultado(raiz);
+        raiz = sucessor;
     }
     
-    if (!raiz) return NULL;
-    
-    // Atualizar altura e balancear
-    raiz->altura = 1 + max(altura_no(raiz->esquerda), altura_no(raiz->direita));
+    // Atualizar altura, tamanho, soma de votos e balancear
+    atualizar_no_resultado(raiz);
     return balancear_no(raiz);
 }
 
@@ -181,39 +257,198 @@ NoArvoreResultados* encontrar_minimo(NoArvoreResultados* raiz) {
 
 // ================= IMPLEMENTAO PERCURSOS =================
 
-void percurso_em_ordem(NoArvoreResultados* raiz, void (*callback)(ResultadoVotacao*)) {
-    if (!raiz) return;
+static inline void empilhar_iterador(IteradorArvore* it, NoArvoreResultados* no, 
+                                     int profundidade, int expandido) {
+    if (!no) return;
+    EntradaIterador* entrada = &it->pilha[it->topo++];
+    entrada->no = no;
+    entrada->profundidade = (short)profundidade;
+    entrada->expandido = (short)expandido;
+}
+
+// Empilha o n e toda a sua descida para a esquerda (ou direita, na ordem
+// reversa), j marcados para visita
+static inline void empilhar_descida(IteradorArvore* it, NoArvoreResultados* no, int profundidade,
+                                    int reversa) {
+    while (no) {
+        EntradaIterador* entrada = &it->pilha[it->topo++];
+        entrada->no = no;
+        entrada->profundidade = (short)profundidade++;
+        entrada->expandido = 1;
+        no = reversa ? no->direita : no->esquerda;
+    }
+}
+
+void iniciar_iterador_arvore(IteradorArvore* it, NoArvoreResultados* raiz, OrdemPercurso ordem) {
+    if (!it) return;
+    it->topo = 0;
+    it->ordem = ordem;
+    it->filtrar = 0;
+    it->tipo = TIPO_RESULTADO;
+    it->profundidade = -1;
+    
+    if (ordem == PERCURSO_EM_ORDEM || ordem == PERCURSO_EM_ORDEM_REVERSA) {
+        empilhar_descida(it, raiz, 0, ordem == PERCURSO_EM_ORDEM_REVERSA);
+    } else {
+        empilhar_iterador(it, raiz, 0, 0);
+    }
+}
+
+void filtrar_iterador_arvore(IteradorArvore* it, TipoNoArvore tipo) {
+    if (!it) return;
+    it->filtrar = 1;
+    it->tipo = tipo;
+}
+
+// Em ordem: a pilha guarda s ns a visitar; ao sair um n, entra a descida
+// do filho oposto. Pr-ordem: o n sai j com os filhos empilhados. Ps-ordem:
+// o n volta  pilha marcado e s  visitado depois dos dois filhos.
+// Cada ordem tem o seu lao, para a escolha no se repetir a cada n.
+NoArvoreResultados* proximo_no_iterador(IteradorArvore* it) {
+    if (!it) return NULL;
+    
+    NoArvoreResultados* no;
+    int prof;
+    switch (it->ordem) {
+        case PERCURSO_EM_ORDEM:
+        case PERCURSO_EM_ORDEM_REVERSA: {
+            int reversa = (it->ordem == PERCURSO_EM_ORDEM_REVERSA);
+            while (it->topo > 0) {
+                EntradaIterador* entrada = &it->pilha[--it->topo];
+                no = entrada->no;
+                prof = entrada->profundidade;
+                empilhar_descida(it, reversa ? no->esquerda : no->direita, prof + 1, reversa);
+                if (!it->filtrar || no->resultado.tipo == it->tipo) goto devolver;
+            }
+            return NULL;
+        }
+        case PERCURSO_PRE_ORDEM:
+            while (it->topo > 0) {
+                EntradaIterador* entrada = &it->pilha[--it->topo];
+                no = entrada->no;
+                prof = entrada->profundidade;
+                empilhar_iterador(it, no->direita, prof + 1, 0);
+                empilhar_iterador(it, no->esquerda, prof + 1, 0);
+                if (!it->filtrar || no->resultado.tipo == it->tipo) goto devolver;
+            }
+            return NULL;
+        case PERCURSO_POS_ORDEM:
+        default:
+            while (it->topo > 0) {
+                EntradaIterador entrada = it->pilha[--it->topo];
+                no = entrada.no;
+                prof = entrada.profundidade;
+                if (!entrada.expandido) {
+                    it->topo++;
+                    it->pilha[it->topo - 1].expandido = 1;
+                    empilhar_iterador(it, no->direita, prof + 1, 0);
+                    empilhar_iterador(it, no->esquerda, prof + 1, 0);
+                    continue;
+                }
+                if (!it->filtrar || no->resultado.tipo == it->tipo) goto devolver;
+            }
+            return NULL;
+    }
     
-    percurso_em_ordem(raiz->esquerda, callback);
-    if (callback) callback(&raiz->resultado);
-    percurso_em_ordem(raiz->direita, callback);
+devolver:
+    it->profundidade = prof;
+    return no;
 }
 
-void percurso_pre_ordem(NoArvoreResultados* raiz, void (*callback)(ResultadoVotacao*)) {
-    if (!raiz) return;
+ResultadoVotacao* proximo_resultado_iterador(IteradorArvore* it) {
+    NoArvoreResultados* no = proximo_no_iterador(it);
+    return no ? &no->resultado : NULL;
+}
+
+// Percurso completo com callback. Quem percorre tudo de uma vez no precisa
+// do iterador passo a passo: em ordem, reversa e pr-ordem rodam aqui num
+// lao s, com pilha local de ponteiros (sem profundidade nem chamada por
+// n), que  o que a recurso custava. Ps-ordem usa o iterador.
+// S um dos callbacks vem preenchido.
+static void percorrer_com_pilha(NoArvoreResultados* raiz, OrdemPercurso ordem, int filtrar,
+                                TipoNoArvore tipo, void (*callback)(ResultadoVotacao*, void*),
+                                void* contexto, void (*callback_simples)(ResultadoVotacao*)) {
+    NoArvoreResultados* pilha[TAMANHO_PILHA_ITERADOR];
+    int topo = 0;
+    NoArvoreResultados* no;
+    
+    if (ordem == PERCURSO_EM_ORDEM || ordem == PERCURSO_EM_ORDEM_REVERSA) {
+        int reversa = (ordem == PERCURSO_EM_ORDEM_REVERSA);
+        no = raiz;
+        for (;;) {
+            // Desce at o extremo, guardando o caminho
+            while (no) {
+                pilha[topo++] = no;
+                no = reversa ? no->direita : no->esquerda;
+            }
+            if (topo == 0) return;
+            no = pilha[--topo];
+            NoArvoreResultados* seguinte = reversa ? no->esquerda : no->direita;
+            if (!filtrar || no->resultado.tipo == tipo) {
+                if (callback) callback(&no->resultado, contexto);
+                else callback_simples(&no->resultado);
+            }
+            no = seguinte;
+        }
+    }
+    
+    if (ordem == PERCURSO_PRE_ORDEM) {
+        if (raiz) pilha[topo++] = raiz;
+        while (topo > 0) {
+            no = pilha[--topo];
+            if (no->direita) pilha[topo++] = no->direita;
+            if (no->esquerda) pilha[topo++] = no->esquerda;
+            if (!filtrar || no->resultado.tipo == tipo) {
+                if (callback) callback(&no->resultado, contexto);
+                else callback_simples(&no->resultado);
+            }
+        }
+        return;
+    }
     
-    if (callback) callback(&raiz->resultado);
-    percurso_pre_ordem(raiz->esquerda, callback);
-    percurso_pre_ordem(raiz->direita, callback);
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, raiz, ordem);
+    if (filtrar) filtrar_iterador_arvore(&it, tipo);
+    while ((no = proximo_no_iterador(&it)) != NULL) {
+        if (callback) callback(&no->resultado, contexto);
+        else callback_simples(&no->resultado);
+    }
+}
+
+void percorrer_arvore_resultados(NoArvoreResultados* raiz, OrdemPercurso ordem,
+                                 void (*callback)(ResultadoVotacao*, void*), void* contexto) {
+    if (!callback) return;
+    percorrer_com_pilha(raiz, ordem, 0, TIPO_RESULTADO, callback, contexto, NULL);
+}
+
+void percorrer_arvore_filtrado(NoArvoreResultados* raiz, OrdemPercurso ordem, TipoNoArvore tipo,
+                               void (*callback)(ResultadoVotacao*, void*), void* contexto) {
+    if (!callback) return;
+    percorrer_com_pilha(raiz, ordem, 1, tipo, callback, contexto, NULL);
+}
+
+// Percursos sem contexto, mantidos para quem j os usa
+static void percorrer_sem_contexto(NoArvoreResultados* raiz, OrdemPercurso ordem, int filtrar,
+                                   TipoNoArvore tipo, void (*callback)(ResultadoVotacao*)) {
+    if (!callback) return;
+    percorrer_com_pilha(raiz, ordem, filtrar, tipo, NULL, NULL, callback);
+}
+
+void percurso_em_ordem(NoArvoreResultados* raiz, void (*callback)(ResultadoVotacao*)) {
+    percorrer_sem_contexto(raiz, PERCURSO_EM_ORDEM, 0, TIPO_RESULTADO, callback);
+}
+
+void percurso_pre_ordem(NoArvoreResultados* raiz, void (*callback)(ResultadoVotacao*)) {
+    percorrer_sem_contexto(raiz, PERCURSO_PRE_ORDEM, 0, TIPO_RESULTADO, callback);
 }
 
 void percurso_pos_ordem(NoArvoreResultados* raiz, void (*callback)(ResultadoVotacao*)) {
-    if (!raiz) return;
-    
-    percurso_pos_ordem(raiz->esquerda, callback);
-    percurso_pos_ordem(raiz->direita, callback);
-    if (callback) callback(&raiz->resultado);
+    percorrer_sem_contexto(raiz, PERCURSO_POS_ORDEM, 0, TIPO_RESULTADO, callback);
 }
 
 void percurso_em_ordem_filtrado(NoArvoreResultados* raiz, TipoNoArvore tipo, 
                                void (*callback)(ResultadoVotacao*)) {
-    if (!raiz) return;
-    
-    percurso_em_ordem_filtrado(raiz->esquerda, tipo, callback);
-    if (raiz->resultado.tipo == tipo && callback) {
-        callback(&raiz->resultado);
-    }
-    percurso_em_ordem_filtrado(raiz->direita, tipo, callback);
+    percorrer_sem_contexto(raiz, PERCURSO_EM_ORDEM, 1, tipo, callback);
 }
 
 // ================= IMPLEMENTAO RVORE AVL =================
@@ -236,9 +471,9 @@ NoArvoreResultados* rotacionar_direita(NoArvoreResultados* y) {
     x->direita = y;
     y->esquerda = T2;
     
-    // Atualizar alturas
-    y->altura = max(altura_no(y->esquerda), altura_no(y->direita)) + 1;
-    x->altura = max(altura_no(x->esquerda), altura_no(x->direita)) + 1;
+    // Atualizar alturas, tamanhos e somas (y agora  filho de x)
+    atualizar_no_resultado(y);
+    atualizar_no_resultado(x);
     
     return x;
 }
@@ -250,9 +485,9 @@ NoArvoreResultados* rotacionar_esquerda(NoArvoreResultados* x) {
     y->esquerda = x;
     x->direita = T2;
     
-    // Atualizar alturas
-    x->altura = max(altura_no(x->esquerda), altura_no(x->direita)) + 1;
-    y->altura = max(altura_no(y->esquerda), altura_no(y->direita)) + 1;
+    // Atualizar alturas, tamanhos e somas (x agora  filho de y)
+    atualizar_no_resultado(x);
+    atualizar_no_resultado(y);
     
     return y;
 }
@@ -356,27 +591,48 @@ ResultadoVotacao criar_resultado_regiao(const char* regiao, int votos_regiao, in
 int atualizar_votos_resultado(ArvoreResultados* arvore, int id, int votos_adicionais) {
     if (!arvore) return 0;
     
-    ResultadoVotacao* resultado = buscar_resultado_por_id(arvore, id);
-    if (!resultado) return 0;
+    // Uma s descida busca o n e j propaga a diferena s somas do
+    // caminho; se o ID no existir, a mesma descida desfaz as somas
+    NoArvoreResultados* atual = arvore->raiz;
+    while (atual && atual->resultado.id != id) {
+        atual->soma_votos += votos_adicionais;
+        atual = (id < atual->resultado.id) ? atual->esquerda : atual->direita;
+    }
+    if (!atual) {
+        for (atual = arvore->raiz; atual; atual = (id < atual->resultado.id) ? atual->esquerda : atual->direita) {
+            atual->soma_votos -= votos_adicionais;
+        }
+        return 0;
+    }
+    atual->soma_votos += votos_adicionais;
     
+    // Reposiciona o resultado no ranking a partir da chave antiga
+    ResultadoVotacao* resultado = &atual->resultado;
+    int votos_anteriores = resultado->votos;
     resultado->votos += votos_adicionais;
+    reposicionar_ranking(arvore, resultado, votos_anteriores);
+    
     arvore->total_votos += votos_adicionais;
+    arvore->percentuais_pendentes = 1;
     
     return 1;
 }
 
+// Os percentuais so recalculados s quando lidos depois de alguma mudana
+// de votos: contar um voto apenas marca a rvore, e a primeira leitura
+// seguinte refaz todos de uma vez. Chamada repetida sem mudanas  O(1).
 int atualizar_percentuais_arvore(ArvoreResultados* arvore) {
     if (!arvore || arvore->total_votos == 0) return 0;
+    if (!arvore->percentuais_pendentes) return 1;
     
-    void atualizar_percentual_no(NoArvoreResultados* no, int total_votos) {
-        if (!no) return;
-        
-        no->resultado.percentual = (float)no->resultado.votos / total_votos * 100;
-        atualizar_percentual_no(no->esquerda, total_votos);
-        atualizar_percentual_no(no->direita, total_votos);
-    }
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
     
-    atualizar_percentual_no(arvore->raiz, arvore->total_votos);
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
+        resultado->percentual = (float)resultado->votos / arvore->total_votos * 100;
+    }
+    arvore->percentuais_pendentes = 0;
     return 1;
 }
 
@@ -384,13 +640,37 @@ int atualizar_percentuais_arvore(ArvoreResultados* arvore) {
 
 int total_nos_arvore(ArvoreResultados* arvore) {
     if (!arvore) return 0;
-    
-    int contar_nos_recursivo(NoArvoreResultados* raiz) {
-        if (!raiz) return 0;
-        return 1 + contar_nos_recursivo(raiz->esquerda) + contar_nos_recursivo(raiz->direita);
+    return tamanho_subarvore(arvore->raiz);
+}
+
+int soma_votos_arvore(ArvoreResultados* arvore) {
+    if (!arvore) return 0;
+    return soma_votos_subarvore(arvore->raiz);
+}
+
+// Votos dos resultados com ID < limite: descendo pela rvore, cada vez que
+// o caminho vai  direita a subrvore esquerda e o prprio n entram inteiros
+static int soma_votos_abaixo_de(NoArvoreResultados* atual, int limite) {
+    int soma = 0;
+    while (atual) {
+        if (atual->resultado.id < limite) {
+            soma += soma_votos_subarvore(atual->esquerda) + atual->resultado.votos;
+            atual = atual->direita;
+        } else {
+            atual = atual->esquerda;
+        }
     }
-    
-    return contar_nos_recursivo(arvore->raiz);
+    return soma;
+}
+
+int soma_votos_intervalo(ArvoreResultados* arvore, int id_min, int id_max) {
+    if (!arvore || id_min > id_max) return 0;
+    
+    int soma = soma_votos_abaixo_de(arvore->raiz, id_min);
+    // id_max + 1 estouraria com INT_MAX
+    int ate_max = (id_max == INT_MAX) ? soma_votos_subarvore(arvore->raiz)
+                                      : soma_votos_abaixo_de(arvore->raiz, id_max + 1);
+    return ate_max - soma;
 }
 
 int altura_arvore(ArvoreResultados* arvore) {
@@ -402,89 +682,53 @@ int arvore_vazia(ArvoreResultados* arvore) {
     return (!arvore || !arvore->raiz);
 }
 
+// Empates ficam com o menor ID (mesma ordem do ranking)
 ResultadoVotacao* candidato_mais_votado_arvore(ArvoreResultados* arvore) {
     if (!arvore || arvore->tipo_arvore != TIPO_CANDIDATO) return NULL;
-    
-    NoArvoreResultados* atual = arvore->raiz;
-    NoArvoreResultados* mais_votado = NULL;
-    
-    // Percorrer a rvore para encontrar o mximo
-    void encontrar_maximo_recursivo(NoArvoreResultados* no) {
-        if (!no) return;
-        
-        if (!mais_votado || no->resultado.votos > mais_votado->resultado.votos) {
-            mais_votado = no;
-        }
-        
-        encontrar_maximo_recursivo(no->esquerda);
-        encontrar_maximo_recursivo(no->direita);
-    }
-    
-    encontrar_maximo_recursivo(atual);
-    return mais_votado ? &(mais_votado->resultado) : NULL;
+    return lider_arvore(arvore);
 }
 
 ResultadoVotacao* candidato_menos_votado_arvore(ArvoreResultados* arvore) {
     if (!arvore || arvore->tipo_arvore != TIPO_CANDIDATO) return NULL;
-    
-    NoArvoreResultados* atual = arvore->raiz;
-    NoArvoreResultados* menos_votado = NULL;
-    
-    // Percorrer a rvore para encontrar o mnimo
-    void encontrar_minimo_recursivo(NoArvoreResultados* no) {
-        if (!no) return;
-        
-        if (!menos_votado || no->resultado.votos < menos_votado->resultado.votos) {
-            menos_votado = no;
-        }
-        
-        encontrar_minimo_recursivo(no->esquerda);
-        encontrar_minimo_recursivo(no->direita);
-    }
-    
-    encontrar_minimo_recursivo(atual);
-    return menos_votado ? &(menos_votado->resultado) : NULL;
+    return ultimo_colocado_arvore(arvore);
 }
 
 ResultadoVotacao* cap_maior_participacao(ArvoreResultados* arvore) {
     if (!arvore || arvore->tipo_arvore != TIPO_CAP) return NULL;
-    
-    // Implementao similar  candidato_mais_votado_arvore
-    return candidato_mais_votado_arvore(arvore); // Reutiliza a mesma lgica
+    return lider_arvore(arvore);
 }
 
 ResultadoVotacao* regiao_maior_participacao(ArvoreResultados* arvore) {
     if (!arvore || arvore->tipo_arvore != TIPO_REGIAO) return NULL;
+    return lider_arvore(arvore);
+}
+
+// Lista, do mais para o menos votado, quem passou do limite: s a parte do
+// ranking acima do corte  visitada
+static void exibir_acima_de_limite(ArvoreResultados* arvore, int limite_votos) {
+    if (limite_votos == INT_MAX) return;
+    
+    IteradorFaixaVotos it;
+    iniciar_iterador_faixa(&it, arvore, limite_votos + 1, INT_MAX);
     
-    // Implementao similar  candidato_mais_votado_arvore
-    return candidato_mais_votado_arvore(arvore); // Reutiliza a mesma lgica
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_iterador_faixa(&it)) != NULL) {
+        exibir_resultado_formatado(resultado);
+    }
 }
 
 void candidatos_acima_de_limite(ArvoreResultados* arvore, int limite_votos) {
     if (!arvore || arvore->tipo_arvore != TIPO_CANDIDATO) return;
     
     printf("\n=== CANDIDATOS COM MAIS DE %d VOTOS ===\n", limite_votos);
-    
-    void verificar_limite_recursivo(NoArvoreResultados* no, int limite) {
-        if (!no) return;
-        
-        verificar_limite_recursivo(no->esquerda, limite);
-        
-        if (no->resultado.votos > limite) {
-            exibir_resultado_formatado(&no->resultado);
-        }
-        
-        verificar_limite_recursivo(no->direita, limite);
-    }
-    
-    verificar_limite_recursivo(arvore->raiz, limite_votos);
+    exibir_acima_de_limite(arvore, limite_votos);
 }
 
 void caps_acima_de_limite(ArvoreResultados* arvore, int limite_votos) {
     if (!arvore || arvore->tipo_arvore != TIPO_CAP) return;
     
     printf("\n=== CAPs COM MAIS DE %d VOTOS ===\n", limite_votos);
-    candidatos_acima_de_limite(arvore, limite_votos); // Reutiliza mesma lgica
+    exibir_acima_de_limite(arvore, limite_votos);
 }
 
 // ================= IMPLEMENTAO VISUALIZAO E EXPORTAO =================
@@ -517,6 +761,7 @@ void exibir_arvore_resultados(ArvoreResultados* arvore) {
         printf("Arvore invalida!\n");
         return;
     }
+    atualizar_percentuais_arvore(arvore);
     
     printf("\n=== ARVORE DE RESULTADOS ===\n");
     printf("Tipo: ");
@@ -536,180 +781,920 @@ void exibir_arvore_resultados(ArvoreResultados* arvore) {
 }
 
 void exibir_arvore_vertical(NoArvoreResultados* raiz, int nivel) {
-    if (!raiz) return;
-    
-    exibir_arvore_vertical(raiz->direita, nivel + 1);
-    
-    for (int i = 0; i < nivel; i++) printf("    ");
-    
-    printf("%d (%s)\n", raiz->resultado.id, raiz->resultado.nome);
-    
-    exibir_arvore_vertical(raiz->esquerda, nivel + 1);
+    // Direita em cima: ordem reversa, recuo pela profundidade
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, raiz, PERCURSO_EM_ORDEM_REVERSA);
+    
+    NoArvoreResultados* no;
+    while ((no = proximo_no_iterador(&it)) != NULL) {
+        for (int i = 0; i < nivel + it.profundidade; i++) printf("    ");
+        printf("%d (%s)\n", no->resultado.id, no->resultado.nome);
+    }
 }
 
 void exibir_arvore_horizontal(NoArvoreResultados* raiz, int espaco) {
-    if (!raiz) return;
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, raiz, PERCURSO_EM_ORDEM_REVERSA);
     
-    espaco += 10;
-    
-    exibir_arvore_horizontal(raiz->direita, espaco);
+    NoArvoreResultados* no;
+    while ((no = proximo_no_iterador(&it)) != NULL) {
+        int recuo = espaco + 10 * (it.profundidade + 1);
+        
+        printf("\n");
+        for (int i = 10; i < recuo; i++) printf(" ");
+        printf("%d\n", no->resultado.id);
+    }
+}
+
+static void exportar_linha_csv(ResultadoVotacao* resultado, void* contexto) {
+    EscritorSaida* saida = (EscritorSaida*)contexto;
     
-    printf("\n");
-    for (int i = 10; i < espaco; i++) printf(" ");
-    printf("%d\n", raiz->resultado.id);
+    const char* tipo_str;
+    switch (resultado->tipo) {
+        case TIPO_CANDIDATO: tipo_str = "CANDIDATO;"; break;
+        case TIPO_CAP: tipo_str = "CAP;"; break;
+        case TIPO_REGIAO: tipo_str = "REGIAO;"; break;
+        default: tipo_str = "DESCONHECIDO;";
+    }
     
-    exibir_arvore_horizontal(raiz->esquerda, espaco);
+    escrever_texto(saida, tipo_str);
+    escrever_inteiro(saida, resultado->id);
+    escrever_bytes(saida, ";", 1);
+    escrever_campo_csv(saida, resultado->nome);
+    escrever_bytes(saida, ";", 1);
+    escrever_inteiro(saida, resultado->votos);
+    escrever_bytes(saida, ";", 1);
+    escrever_decimal(saida, resultado->percentual);
+    escrever_bytes(saida, "\n", 1);
 }
 
 int exportar_resultados_csv(ArvoreResultados* arvore, const char* filename) {
     if (!arvore || !filename) return 0;
+    atualizar_percentuais_arvore(arvore);
     
-    FILE* arquivo = fopen(filename, "w");
-    if (!arquivo) return 0;
+    EscritorSaida* saida = criar_escritor_arquivo(filename, 0);
+    if (!saida) return 0;
     
     // Cabealho
-    fprintf(arquivo, "Tipo;ID;Nome;Votos;Percentual\n");
+    escrever_texto(saida, "Tipo;ID;Nome;Votos;Percentual\n");
     
     // Dados
-    void exportar_no_csv(NoArvoreResultados* no) {
-        if (!no) return;
-        
-        const char* tipo_str;
-        switch (no->resultado.tipo) {
-            case TIPO_CANDIDATO: tipo_str = "CANDIDATO"; break;
-            case TIPO_CAP: tipo_str = "CAP"; break;
-            case TIPO_REGIAO: tipo_str = "REGIAO"; break;
-            default: tipo_str = "DESCONHECIDO";
-        }
-        
-        fprintf(arquivo, "%s;%d;%s;%d;%.2f\n",
-                tipo_str,
-                no->resultado.id,
-                no->resultado.nome,
-                no->resultado.votos,
-                no->resultado.percentual);
-        
-        exportar_no_csv(no->esquerda);
-        exportar_no_csv(no->direita);
-    }
-    
-    exportar_no_csv(arvore->raiz);
-    fclose(arquivo);
+    percorrer_arvore_resultados(arvore->raiz, PERCURSO_PRE_ORDEM, exportar_linha_csv, saida);
+    if (!fechar_escritor(saida)) return 0;
     
     printf("Resultados exportados para %s\n", filename);
     return 1;
 }
 
+// Contexto da exportao JSON: a vrgula vai antes de todo objeto exceto o primeiro
+typedef struct {
+    EscritorSaida* saida;
+    int primeiro;
+} ContextoJson;
+
+static void exportar_objeto_json(ResultadoVotacao* resultado, void* contexto) {
+    ContextoJson* ctx = (ContextoJson*)contexto;
+    EscritorSaida* saida = ctx->saida;
+    
+    escrever_texto(saida, ctx->primeiro ? "    {\n      \"id\": " : ",\n    {\n      \"id\": ");
+    ctx->primeiro = 0;
+    
+    escrever_inteiro(saida, resultado->id);
+    escrever_texto(saida, ",\n      \"nome\": ");
+    escrever_string_json(saida, resultado->nome);
+    escrever_texto(saida, ",\n      \"votos\": ");
+    escrever_inteiro(saida, resultado->votos);
+    escrever_texto(saida, ",\n      \"percentual\": ");
+    escrever_decimal(saida, resultado->percentual);
+    escrever_texto(saida, "\n    }");
+}
+
 int exportar_resultados_json(ArvoreResultados* arvore, const char* filename) {
     if (!arvore || !filename) return 0;
+    atualizar_percentuais_arvore(arvore);
     
-    FILE* arquivo = fopen(filename, "w");
-    if (!arquivo) return 0;
+    EscritorSaida* saida = criar_escritor_arquivo(filename, 0);
+    if (!saida) return 0;
     
-    fprintf(arquivo, "{\n");
-    fprintf(arquivo, "  \"tipo\": \"");
+    escrever_texto(saida, "{\n  \"tipo\": \"");
     
     switch (arvore->tipo_arvore) {
-        case TIPO_CANDIDATO: fprintf(arquivo, "candidatos"); break;
-        case TIPO_CAP: fprintf(arquivo, "caps"); break;
-        case TIPO_REGIAO: fprintf(arquivo, "regioes"); break;
-        default: fprintf(arquivo, "desconhecido");
+        case TIPO_CANDIDATO: escrever_texto(saida, "candidatos"); break;
+        case TIPO_CAP: escrever_texto(saida, "caps"); break;
+        case TIPO_REGIAO: escrever_texto(saida, "regioes"); break;
+        default: escrever_texto(saida, "desconhecido");
     }
     
-    fprintf(arquivo, "\",\n");
-    fprintf(arquivo, "  \"total_votos\": %d,\n", arvore->total_votos);
-    fprintf(arquivo, "  \"resultados\": [\n");
+    escrever_texto(saida, "\",\n  \"total_votos\": ");
+    escrever_inteiro(saida, arvore->total_votos);
+    escrever_texto(saida, ",\n  \"resultados\": [\n");
     
-    int primeiro = 1;
-    void exportar_no_json(NoArvoreResultados* no) {
-        if (!no) return;
-        
-        exportar_no_json(no->esquerda);
-        
-        if (!primeiro) fprintf(arquivo, ",\n");
-        primeiro = 0;
-        
-        fprintf(arquivo, "    {\n");
-        fprintf(arquivo, "      \"id\": %d,\n", no->resultado.id);
-        fprintf(arquivo, "      \"nome\": \"%s\",\n", no->resultado.nome);
-        fprintf(arquivo, "      \"votos\": %d,\n", no->resultado.votos);
-        fprintf(arquivo, "      \"percentual\": %.2f\n", no->resultado.percentual);
-        fprintf(arquivo, "    }");
-        
-        exportar_no_json(no->direita);
-    }
-    
-    exportar_no_json(arvore->raiz);
+    ContextoJson ctx = { saida, 1 };
+    percorrer_arvore_resultados(arvore->raiz, PERCURSO_EM_ORDEM, exportar_objeto_json, &ctx);
     
-    fprintf(arquivo, "\n  ]\n");
-    fprintf(arquivo, "}\n");
+    escrever_texto(saida, "\n  ]\n}\n");
+    if (!fechar_escritor(saida)) return 0;
     
-    fclose(arquivo);
     printf("Resultados exportados para %s (JSON)\n", filename);
     return 1;
 }
 
 // ================= IMPLEMENTAO FUNES DE ORDENAO =================
 
+// Critrio do ranking: mais votos primeiro e, no empate, menor ID primeiro.
+// Como o ID  nico na rvore, a ordem  total e o resultado no depende
+// do algoritmo de ordenao usado.
+static int comparar_resultados_decrescente(const void* a, const void* b) {
+    const ResultadoVotacao* ra = *(const ResultadoVotacao* const*)a;
+    const ResultadoVotacao* rb = *(const ResultadoVotacao* const*)b;
+
+    if (ra->votos != rb->votos) return (ra->votos < rb->votos) ? 1 : -1;
+    return (ra->id > rb->id) - (ra->id < rb->id);
+}
+
+// Menos votos primeiro; o empate continua sendo desfeito pelo menor ID
+static int comparar_resultados_crescente(const void* a, const void* b) {
+    const ResultadoVotacao* ra = *(const ResultadoVotacao* const*)a;
+    const ResultadoVotacao* rb = *(const ResultadoVotacao* const*)b;
+
+    if (ra->votos != rb->votos) return (ra->votos > rb->votos) ? 1 : -1;
+    return (ra->id > rb->id) - (ra->id < rb->id);
+}
+
+// Copia os ponteiros dos resultados em ordem de ID
+static void coletar_resultados_em_ordem(NoArvoreResultados* no, 
+                                        ResultadoVotacao** array, int* indice) {
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, no, PERCURSO_EM_ORDEM);
+    
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
+        array[(*indice)++] = resultado;
+    }
+}
+
 void ordenar_resultados_decrescente(ArvoreResultados* arvore, 
                                    ResultadoVotacao** array, int* indice) {
     if (!arvore || !array || !indice) return;
+    atualizar_percentuais_arvore(arvore);
     
-    void coletar_resultados(NoArvoreResultados* no) {
-        if (!no) return;
-        
-        coletar_resultados(no->esquerda);
-        array[(*indice)++] = &(no->resultado);
-        coletar_resultados(no->direita);
-    }
+    *indice = 0;
+    coletar_resultados_em_ordem(arvore->raiz, array, indice);
+    qsort(array, *indice, sizeof(ResultadoVotacao*), comparar_resultados_decrescente);
+}
+
+void ordenar_resultados_crescente(ArvoreResultados* arvore, 
+                                 ResultadoVotacao** array, int* indice) {
+    if (!arvore || !array || !indice) return;
+    atualizar_percentuais_arvore(arvore);
     
     *indice = 0;
-    coletar_resultados(arvore->raiz);
-    
-    // Ordenao por bolha decrescente (por votos)
-    for (int i = 0; i < *indice - 1; i++) {
-        for (int j = 0; j < *indice - i - 1; j++) {
-            if (array[j]->votos < array[j + 1]->votos) {
-                ResultadoVotacao* temp = array[j];
-                array[j] = array[j + 1];
-                array[j + 1] = temp;
-            }
-        }
-    }
+    coletar_resultados_em_ordem(arvore->raiz, array, indice);
+    qsort(array, *indice, sizeof(ResultadoVotacao*), comparar_resultados_crescente);
 }
 
 ResultadoVotacao** obter_resultados_ordenados(ArvoreResultados* arvore, int ordem) {
     if (!arvore) return NULL;
+    atualizar_percentuais_arvore(arvore);
     
     int n = total_nos_arvore(arvore);
-    ResultadoVotacao** array = (ResultadoVotacao**)malloc(n * sizeof(ResultadoVotacao*));
+    ResultadoVotacao** array = (ResultadoVotacao**)malloc((n > 0 ? n : 1) * sizeof(ResultadoVotacao*));
     
     if (!array) return NULL;
     
     int indice = 0;
+    coletar_resultados_em_ordem(arvore->raiz, array, &indice);
+    
+    // Ordem 1 = decrescente por votos; qualquer outra mantm a ordem de ID
+    if (ordem == 1) {
+        qsort(array, indice, sizeof(ResultadoVotacao*), comparar_resultados_decrescente);
+    }
+    
+    return array;
+}
+
+// ================= IMPLEMENTAO NDICE DE RANKING =================
+
+// Cada n guarda a chave (votos, id) com que foi indexado e aponta para o
+// resultado na rvore principal, cujo endereo  estvel. A chave  uma
+// cpia porque os votos mudam antes de o n ser reposicionado.
+
+// Negativo se (votos_a, id_a) vem antes de (votos_b, id_b) no ranking
+static int comparar_chave_ranking(int votos_a, int id_a, int votos_b, int id_b) {
+    if (votos_a != votos_b) return (votos_a > votos_b) ? -1 : 1;
+    return (id_a > id_b) - (id_a < id_b);
+}
+
+static int altura_ranking(NoRanking* no) {
+    return no ? no->altura : 0;
+}
+
+static int tamanho_ranking(NoRanking* no) {
+    return no ? no->tamanho : 0;
+}
+
+static void atualizar_no_ranking(NoRanking* no) {
+    no->altura = 1 + max(altura_ranking(no->esquerda), altura_ranking(no->direita));
+    no->tamanho = 1 + tamanho_ranking(no->esquerda) + tamanho_ranking(no->direita);
+}
+
+static NoRanking* rotacionar_ranking_direita(NoRanking* y) {
+    NoRanking* x = y->esquerda;
+    y->esquerda = x->direita;
+    x->direita = y;
+    atualizar_no_ranking(y);
+    atualizar_no_ranking(x);
+    return x;
+}
+
+static NoRanking* rotacionar_ranking_esquerda(NoRanking* x) {
+    NoRanking* y = x->direita;
+    x->direita = y->esquerda;
+    y->esquerda = x;
+    atualizar_no_ranking(x);
+    atualizar_no_ranking(y);
+    return y;
+}
+
+static NoRanking* balancear_ranking(NoRanking* no) {
+    atualizar_no_ranking(no);
+    int balance = altura_ranking(no->esquerda) - altura_ranking(no->direita);
+    
+    if (balance > 1) {
+        if (altura_ranking(no->esquerda->esquerda) < altura_ranking(no->esquerda->direita)) {
+            no->esquerda = rotacionar_ranking_esquerda(no->esquerda);
+        }
+        return rotacionar_ranking_direita(no);
+    }
+    if (balance < -1) {
+        if (altura_ranking(no->direita->direita) < altura_ranking(no->direita->esquerda)) {
+            no->direita = rotacionar_ranking_direita(no->direita);
+        }
+        return rotacionar_ranking_esquerda(no);
+    }
+    return no;
+}
+
+static NoRanking* inserir_no_ranking(NoRanking* raiz, NoRanking* novo) {
+    if (!raiz) return novo;
+    
+    // As chaves so nicas (o ID  nico na rvore principal)
+    if (comparar_chave_ranking(novo->votos, novo->id, raiz->votos, raiz->id) < 0) {
+        raiz->esquerda = inserir_no_ranking(raiz->esquerda, novo);
+    } else {
+        raiz->direita = inserir_no_ranking(raiz->direita, novo);
+    }
     
-    // Coletar resultados em array
-    void coletar_em_array(NoArvoreResultados* no) {
+    return balancear_ranking(raiz);
+}
+
+// Desliga a chave do ndice sem liberar memria: *removido recebe o n
+// fsico que saiu da rvore, para ser reaproveitado ou liberado por quem chamou
+static NoRanking* remover_no_ranking(NoRanking* raiz, int votos, int id, NoRanking** removido) {
+    if (!raiz) return NULL;
+    
+    int cmp = comparar_chave_ranking(votos, id, raiz->votos, raiz->id);
+    if (cmp < 0) {
+        raiz->esquerda = remover_no_ranking(raiz->esquerda, votos, id, removido);
+    } else if (cmp > 0) {
+        raiz->direita = remover_no_ranking(raiz->direita, votos, id, removido);
+    } else {
+        if (!raiz->esquerda || !raiz->direita) {
+            *removido = raiz;
+            return raiz->esquerda ? raiz->esquerda : raiz->direita;
+        }
+        
+        // Dois filhos: o contedo do sucessor vem para c e o n dele sai
+        NoRanking* sucessor = raiz->direita;
+        while (sucessor->esquerda) sucessor = sucessor->esquerda;
+        raiz->votos = sucessor->votos;
+        raiz->id = sucessor->id;
+        raiz->resultado = sucessor->resultado;
+        raiz->direita = remover_no_ranking(raiz->direita, sucessor->votos, sucessor->id, removido);
+    }
+    
+    return balancear_ranking(raiz);
+}
+
+// S libera ns alocados um a um; os da carga em lote saem com o bloco
+static void liberar_no_ranking(ArvoreResultados* arvore, NoRanking* no) {
+    if (!no) return;
+    if (arvore->nos_no_bloco > 0 && no >= arvore->bloco_ranking &&
+        no < arvore->bloco_ranking + arvore->nos_no_bloco) return;
+    free(no);
+}
+
+static void destruir_ranking(ArvoreResultados* arvore, NoRanking* no) {
+    if (!no) return;
+    destruir_ranking(arvore, no->esquerda);
+    destruir_ranking(arvore, no->direita);
+    liberar_no_ranking(arvore, no);
+}
+
+// Primeiro, segundo e ltimo colocados, lidos direto do ndice: a descida
+// mais  esquerda d o lder; o segundo  o menor da subrvore direita do
+// lder ou, se ela no existe, o pai dele; a descida  direita d o ltimo
+static void atualizar_extremos(ArvoreResultados* arvore) {
+    arvore->lider = NULL;
+    arvore->vice = NULL;
+    arvore->ultimo_colocado = NULL;
+    
+    NoRanking* no = arvore->ranking;
+    if (!no) return;
+    
+    NoRanking* pai = NULL;
+    while (no->esquerda) {
+        pai = no;
+        no = no->esquerda;
+    }
+    arvore->lider = no->resultado;
+    
+    if (no->direita) {
+        NoRanking* seguinte = no->direita;
+        while (seguinte->esquerda) seguinte = seguinte->esquerda;
+        arvore->vice = seguinte->resultado;
+    } else if (pai) {
+        arvore->vice = pai->resultado;
+    }
+    
+    no = arvore->ranking;
+    while (no->direita) no = no->direita;
+    arvore->ultimo_colocado = no->resultado;
+}
+
+// Indexa o resultado com os votos atuais, reaproveitando o n se vier um.
+// Lder, vice e ltimo ficam para quem chamou (atualizar_extremos)
+static void indexar_ranking(ArvoreResultados* arvore, NoRanking* no, ResultadoVotacao* resultado) {
+    if (!no) {
+        no = (NoRanking*)malloc(sizeof(NoRanking));
         if (!no) return;
-        coletar_em_array(no->esquerda);
-        array[indice++] = &(no->resultado);
-        coletar_em_array(no->direita);
     }
     
-    coletar_em_array(arvore->raiz);
+    no->votos = resultado->votos;
+    no->id = resultado->id;
+    no->resultado = resultado;
+    no->esquerda = NULL;
+    no->direita = NULL;
+    no->altura = 1;
+    no->tamanho = 1;
     
-    // Ordenar
-    if (ordem == 1) { // Decrescente
-        for (int i = 0; i < n - 1; i++) {
-            for (int j = 0; j < n - i - 1; j++) {
-                if (array[j]->votos < array[j + 1]->votos) {
-                    ResultadoVotacao* temp = array[j];
-                    array[j] = array[j + 1];
-                    array[j + 1] = temp;
-                }
-            }
+    arvore->ranking = inserir_no_ranking(arvore->ranking, no);
+}
+
+// Tira o resultado do ndice (pelos votos ainda no alterados) e devolve o
+// n desligado, ou NULL se ele no estava indexado
+static NoRanking* desindexar_ranking(ArvoreResultados* arvore, ResultadoVotacao* resultado) {
+    NoRanking* removido = NULL;
+    arvore->ranking = remover_no_ranking(arvore->ranking, resultado->votos, resultado->id, &removido);
+    return removido;
+}
+
+// N do ranking com a chave (votos, id) e os vizinhos dele na ordem do
+// ranking (NULL nas pontas), numa s descida
+static NoRanking* localizar_no_ranking(NoRanking* raiz, int votos, int id,
+                                       NoRanking** anterior, NoRanking** seguinte) {
+    *anterior = NULL;
+    *seguinte = NULL;
+    
+    NoRanking* atual = raiz;
+    while (atual) {
+        int cmp = comparar_chave_ranking(votos, id, atual->votos, atual->id);
+        if (cmp == 0) break;
+        if (cmp < 0) {
+            *seguinte = atual;
+            atual = atual->esquerda;
+        } else {
+            *anterior = atual;
+            atual = atual->direita;
         }
     }
+    if (!atual) return NULL;
     
-    return array;
+    // Com subrvores, os vizinhos so o maior da esquerda e o menor da direita
+    if (atual->esquerda) {
+        NoRanking* no = atual->esquerda;
+        while (no->direita) no = no->direita;
+        *anterior = no;
+    }
+    if (atual->direita) {
+        NoRanking* no = atual->direita;
+        while (no->esquerda) no = no->esquerda;
+        *seguinte = no;
+    }
+    return atual;
+}
+
+// Leva ao lugar certo do ranking o resultado cujos votos acabaram de mudar.
+// Se a chave nova ainda cabe entre os vizinhos (o caso comum de +1 voto),
+// s a chave do n muda e lder, vice e ltimo continuam os mesmos; seno o
+// n sai com a chave antiga e volta com a nova, sem alocao
+static void reposicionar_ranking(ArvoreResultados* arvore, ResultadoVotacao* resultado, int votos_anteriores) {
+    NoRanking* anterior;
+    NoRanking* seguinte;
+    NoRanking* no = localizar_no_ranking(arvore->ranking, votos_anteriores, resultado->id,
+                                         &anterior, &seguinte);
+    
+    if (no &&
+        (!anterior || comparar_chave_ranking(anterior->votos, anterior->id,
+                                             resultado->votos, resultado->id) < 0) &&
+        (!seguinte || comparar_chave_ranking(resultado->votos, resultado->id,
+                                             seguinte->votos, seguinte->id) < 0)) {
+        no->votos = resultado->votos;
+        return;
+    }
+    
+    NoRanking* removido = NULL;
+    if (no) {
+        arvore->ranking = remover_no_ranking(arvore->ranking, votos_anteriores, resultado->id, &removido);
+    }
+    indexar_ranking(arvore, removido, resultado);
+    atualizar_extremos(arvore);
+}
+
+int posicao_ranking(ArvoreResultados* arvore, int id) {
+    if (!arvore) return 0;
+    
+    ResultadoVotacao* resultado = buscar_resultado_por_id(arvore, id);
+    if (!resultado) return 0;
+    
+    // Soma quem fica  esquerda do caminho at a chave
+    int posicao = 0;
+    NoRanking* atual = arvore->ranking;
+    while (atual) {
+        int cmp = comparar_chave_ranking(resultado->votos, id, atual->votos, atual->id);
+        if (cmp < 0) {
+            atual = atual->esquerda;
+        } else {
+            posicao += tamanho_ranking(atual->esquerda) + 1;
+            if (cmp == 0) return posicao;
+            atual = atual->direita;
+        }
+    }
+    return 0;
+}
+
+ResultadoVotacao* resultado_na_posicao(ArvoreResultados* arvore, int posicao) {
+    if (!arvore || posicao < 1 || posicao > tamanho_ranking(arvore->ranking)) return NULL;
+    atualizar_percentuais_arvore(arvore);
+    
+    NoRanking* atual = arvore->ranking;
+    while (atual) {
+        int antes = tamanho_ranking(atual->esquerda);
+        if (posicao <= antes) {
+            atual = atual->esquerda;
+        } else if (posicao == antes + 1) {
+            return atual->resultado;
+        } else {
+            posicao -= antes + 1;
+            atual = atual->direita;
+        }
+    }
+    return NULL;
+}
+
+// ================= IMPLEMENTAO LDER E SEGUNDO COLOCADO =================
+
+// As consultas abaixo so O(1): os extremos so mantidos a cada mudana de
+// votos. S o percentual do resultado devolvido  acertado, para que um
+// painel consultando sem parar no force o reclculo da rvore inteira.
+static ResultadoVotacao* com_percentual(ArvoreResultados* arvore, ResultadoVotacao* resultado) {
+    if (resultado) {
+        resultado->percentual = arvore->total_votos > 0
+            ? (float)resultado->votos / arvore->total_votos * 100
+            : 0.0f;
+    }
+    return resultado;
+}
+
+ResultadoVotacao* lider_arvore(ArvoreResultados* arvore) {
+    return arvore ? com_percentual(arvore, arvore->lider) : NULL;
+}
+
+ResultadoVotacao* segundo_colocado_arvore(ArvoreResultados* arvore) {
+    return arvore ? com_percentual(arvore, arvore->vice) : NULL;
+}
+
+ResultadoVotacao* ultimo_colocado_arvore(ArvoreResultados* arvore) {
+    return arvore ? com_percentual(arvore, arvore->ultimo_colocado) : NULL;
+}
+
+int margem_vitoria_arvore(ArvoreResultados* arvore) {
+    if (!arvore || !arvore->lider) return 0;
+    return arvore->lider->votos - (arvore->vice ? arvore->vice->votos : 0);
+}
+
+// ================= IMPLEMENTAO TOP-K =================
+
+// Percorre o ndice em ordem e para ao juntar k resultados: O(log n + k),
+// sem visitar o restante da rvore
+static void coletar_topk_ranking(NoRanking* no, ResultadoVotacao** destino, int* quantidade, int k) {
+    if (!no || *quantidade >= k) return;
+    
+    coletar_topk_ranking(no->esquerda, destino, quantidade, k);
+    if (*quantidade >= k) return;
+    
+    destino[(*quantidade)++] = no->resultado;
+    
+    coletar_topk_ranking(no->direita, destino, quantidade, k);
+}
+
+ResultadoVotacao** obter_top_resultados(ArvoreResultados* arvore, int k, int* quantidade) {
+    if (quantidade) *quantidade = 0;
+    if (!arvore || k <= 0) return NULL;
+    atualizar_percentuais_arvore(arvore);
+    
+    int n = tamanho_ranking(arvore->ranking);
+    if (k > n) k = n;
+    if (k == 0) return NULL;
+    
+    ResultadoVotacao** destino = (ResultadoVotacao**)malloc(k * sizeof(ResultadoVotacao*));
+    if (!destino) return NULL;
+    
+    int coletados = 0;
+    coletar_topk_ranking(arvore->ranking, destino, &coletados, k);
+    
+    if (quantidade) *quantidade = coletados;
+    return destino;
+}
+
+// ================= IMPLEMENTAO CONSULTA POR FAIXA DE VOTOS =================
+
+// Quantos resultados tm pelo menos 'votos' votos: como o ranking est em
+// votos decrescentes, basta somar o que fica  esquerda do ponto de corte
+static int contar_com_pelo_menos(NoRanking* no, int votos) {
+    int quantidade = 0;
+    while (no) {
+        if (no->votos >= votos) {
+            quantidade += tamanho_ranking(no->esquerda) + 1;
+            no = no->direita;
+        } else {
+            no = no->esquerda;
+        }
+    }
+    return quantidade;
+}
+
+int contar_resultados_na_faixa(ArvoreResultados* arvore, int votos_min, int votos_max) {
+    if (!arvore || votos_min > votos_max) return 0;
+    
+    int ate_min = contar_com_pelo_menos(arvore->ranking, votos_min);
+    int acima_max = (votos_max == INT_MAX) ? 0 : contar_com_pelo_menos(arvore->ranking, votos_max + 1);
+    return ate_min - acima_max;
+}
+
+// Empilha o caminho at o primeiro n com no mximo votos_max votos; os
+// ns mais votados e as subrvores  esquerda deles ficam de fora
+void iniciar_iterador_faixa(IteradorFaixaVotos* it, ArvoreResultados* arvore,
+                            int votos_min, int votos_max) {
+    if (!it) return;
+    it->topo = 0;
+    it->votos_min = votos_min;
+    if (!arvore || votos_min > votos_max) return;
+    atualizar_percentuais_arvore(arvore);
+    
+    NoRanking* no = arvore->ranking;
+    while (no) {
+        if (no->votos > votos_max) {
+            no = no->direita;
+        } else {
+            it->pilha[it->topo++] = no;
+            no = no->esquerda;
+        }
+    }
+}
+
+ResultadoVotacao* proximo_iterador_faixa(IteradorFaixaVotos* it) {
+    if (!it || it->topo == 0) return NULL;
+    
+    NoRanking* no = it->pilha[--it->topo];
+    if (no->votos < it->votos_min) {
+        it->topo = 0; // Daqui em diante todos esto abaixo da faixa
+        return NULL;
+    }
+    
+    NoRanking* filho = no->direita;
+    while (filho) {
+        it->pilha[it->topo++] = filho;
+        filho = filho->esquerda;
+    }
+    return no->resultado;
+}
+
+int proxima_pagina_faixa(IteradorFaixaVotos* it, ResultadoVotacao** pagina, int tamanho_pagina) {
+    if (!it || !pagina) return 0;
+    
+    int quantidade = 0;
+    ResultadoVotacao* resultado;
+    while (quantidade < tamanho_pagina && (resultado = proximo_iterador_faixa(it)) != NULL) {
+        pagina[quantidade++] = resultado;
+    }
+    return quantidade;
+}
+
+ResultadoVotacao** resultados_na_faixa(ArvoreResultados* arvore, int votos_min, int votos_max,
+                                       int* quantidade) {
+    if (quantidade) *quantidade = 0;
+    
+    // A contagem exata sai dos tamanhos das subrvores, sem percorrer nada
+    int total = contar_resultados_na_faixa(arvore, votos_min, votos_max);
+    if (total == 0) return NULL;
+    
+    ResultadoVotacao** destino = (ResultadoVotacao**)malloc(total * sizeof(ResultadoVotacao*));
+    if (!destino) return NULL;
+    
+    IteradorFaixaVotos it;
+    iniciar_iterador_faixa(&it, arvore, votos_min, votos_max);
+    int coletados = proxima_pagina_faixa(&it, destino, total);
+    
+    if (quantidade) *quantidade = coletados;
+    return destino;
+}
+
+// ================= IMPLEMENTAO CARGA EM LOTE =================
+
+// Intercala a e b (ambos ordenados por ID) em destino; no empate a vem
+// antes, o que mantm a ordem de chegada
+static void intercalar_por_id(ResultadoVotacao** a, int na, ResultadoVotacao** b, int nb,
+                              ResultadoVotacao** destino) {
+    int i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        destino[k++] = (b[j]->id < a[i]->id) ? b[j++] : a[i++];
+    }
+    while (i < na) destino[k++] = a[i++];
+    while (j < nb) destino[k++] = b[j++];
+}
+
+// Ordenao estvel (intercalao de baixo para cima): com IDs repetidos o
+// primeiro da entrada continua na frente, como na insero um a um
+static int ordenar_por_id(ResultadoVotacao** itens, int n) {
+    if (n < 2) return 1;
+    
+    ResultadoVotacao** auxiliar = (ResultadoVotacao**)malloc(n * sizeof(ResultadoVotacao*));
+    if (!auxiliar) return 0;
+    
+    ResultadoVotacao** origem = itens;
+    ResultadoVotacao** destino = auxiliar;
+    for (int largura = 1; largura < n; largura *= 2) {
+        for (int inicio = 0; inicio < n; inicio += 2 * largura) {
+            int meio = inicio + largura < n ? inicio + largura : n;
+            int fim = inicio + 2 * largura < n ? inicio + 2 * largura : n;
+            intercalar_por_id(origem + inicio, meio - inicio, origem + meio, fim - meio, destino + inicio);
+        }
+        ResultadoVotacao** temp = origem;
+        origem = destino;
+        destino = temp;
+    }
+    
+    if (origem != itens) memcpy(itens, origem, n * sizeof(ResultadoVotacao*));
+    free(auxiliar);
+    return 1;
+}
+
+// Liga nos[inicio..fim) como rvore perfeitamente balanceada: o meio vira a
+// raiz, ento as alturas dos lados diferem no mximo em 1 (AVL vlida)
+static NoArvoreResultados* ligar_balanceada(NoArvoreResultados* nos, int inicio, int fim) {
+    if (inicio >= fim) return NULL;
+    
+    int meio = inicio + (fim - inicio) / 2;
+    NoArvoreResultados* raiz = &nos[meio];
+    raiz->esquerda = ligar_balanceada(nos, inicio, meio);
+    raiz->direita = ligar_balanceada(nos, meio + 1, fim);
+    atualizar_no_resultado(raiz);
+    return raiz;
+}
+
+static NoRanking* ligar_ranking_balanceado(NoRanking* nos, int inicio, int fim) {
+    if (inicio >= fim) return NULL;
+    
+    int meio = inicio + (fim - inicio) / 2;
+    NoRanking* raiz = &nos[meio];
+    raiz->esquerda = ligar_ranking_balanceado(nos, inicio, meio);
+    raiz->direita = ligar_ranking_balanceado(nos, meio + 1, fim);
+    atualizar_no_ranking(raiz);
+    return raiz;
+}
+
+static int comparar_nos_ranking(const void* a, const void* b) {
+    const NoRanking* na = (const NoRanking*)a;
+    const NoRanking* nb = (const NoRanking*)b;
+    return comparar_chave_ranking(na->votos, na->id, nb->votos, nb->id);
+}
+
+ArvoreResultados* construir_arvore_resultados(TipoNoArvore tipo, ResultadoVotacao* resultados,
+                                              int quantidade) {
+    if (quantidade < 0 || (quantidade > 0 && !resultados)) return NULL;
+    
+    ArvoreResultados* arvore = criar_arvore_resultados(tipo);
+    if (!arvore || quantidade == 0) return arvore;
+    
+    // Entrada j ordenada por ID  usada direto; seno ordena ponteiros
+    // para ela, sem mexer no array de quem chamou
+    ResultadoVotacao** ordem = NULL;
+    int ordenada = 1;
+    for (int i = 1; i < quantidade && ordenada; i++) {
+        if (resultados[i].id < resultados[i - 1].id) ordenada = 0;
+    }
+    if (!ordenada) {
+        ordem = (ResultadoVotacao**)malloc(quantidade * sizeof(ResultadoVotacao*));
+        if (!ordem) {
+            destruir_arvore_resultados(arvore);
+            return NULL;
+        }
+        for (int i = 0; i < quantidade; i++) ordem[i] = &resultados[i];
+        if (!ordenar_por_id(ordem, quantidade)) {
+            free(ordem);
+            destruir_arvore_resultados(arvore);
+            return NULL;
+        }
+    }
+    
+    int distintos = 1;
+    for (int i = 1; i < quantidade; i++) {
+        int anterior = ordem ? ordem[i - 1]->id : resultados[i - 1].id;
+        int atual = ordem ? ordem[i]->id : resultados[i].id;
+        if (atual != anterior) distintos++;
+    }
+    
+    // Um s bloco: ns da rvore seguidos dos ns do ranking
+    NoArvoreResultados* nos = (NoArvoreResultados*)malloc(
+        distintos * (sizeof(NoArvoreResultados) + sizeof(NoRanking)));
+    if (!nos) {
+        free(ordem);
+        destruir_arvore_resultados(arvore);
+        return NULL;
+    }
+    NoRanking* ranking = (NoRanking*)(nos + distintos);
+    
+    // ID repetido soma os votos no primeiro, como inserir_resultado_arvore
+    int n = 0;
+    for (int i = 0; i < quantidade; i++) {
+        ResultadoVotacao* resultado = ordem ? ordem[i] : &resultados[i];
+        if (n > 0 && nos[n - 1].resultado.id == resultado->id) {
+            nos[n - 1].resultado.votos += resultado->votos;
+        } else {
+            nos[n].resultado = *resultado;
+            nos[n].em_bloco = 1;
+            n++;
+        }
+        arvore->total_votos += resultado->votos;
+    }
+    free(ordem);
+    
+    arvore->raiz = ligar_balanceada(nos, 0, n);
+    
+    for (int i = 0; i < n; i++) {
+        ranking[i].votos = nos[i].resultado.votos;
+        ranking[i].id = nos[i].resultado.id;
+        ranking[i].resultado = &nos[i].resultado;
+    }
+    qsort(ranking, n, sizeof(NoRanking), comparar_nos_ranking);
+    arvore->ranking = ligar_ranking_balanceado(ranking, 0, n);
+    
+    arvore->bloco_nos = nos;
+    arvore->bloco_ranking = ranking;
+    arvore->nos_no_bloco = n;
+    arvore->percentuais_pendentes = 1;
+    atualizar_extremos(arvore);
+    
+    return arvore;
+}
+
+// ================= IMPLEMENTAO NDICE DE NOMES =================
+
+// Os ns da rvore no mudam de endereo enquanto existem (a remoo religa
+// em vez de copiar), ento o ndice aponta direto para o ResultadoVotacao.
+// Nomes repetidos ficam todos no ndice; a busca devolve um deles.
+
+#define CAPACIDADE_INICIAL_INDICE_NOMES 16
+
+// FNV-1a de 32 bits
+static unsigned int hash_nome(const char* nome) {
+    unsigned int h = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)nome; *p; p++) {
+        h ^= *p;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+static void inserir_entrada_indice(IndiceNomes* indice, unsigned int hash, ResultadoVotacao* resultado) {
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    unsigned int i = hash & mascara;
+    while (indice->entradas[i].resultado) i = (i + 1) & mascara;
+    indice->entradas[i].hash = hash;
+    indice->entradas[i].resultado = resultado;
+    indice->quantidade++;
+}
+
+// Dobra a tabela e reinsere tudo; ocupao mxima de 3/4
+static int crescer_indice_nomes(IndiceNomes* indice) {
+    int nova_capacidade = indice->capacidade * 2;
+    EntradaIndiceNomes* novas = (EntradaIndiceNomes*)calloc(nova_capacidade, sizeof(EntradaIndiceNomes));
+    if (!novas) return 0;
+    
+    EntradaIndiceNomes* antigas = indice->entradas;
+    int capacidade_antiga = indice->capacidade;
+    
+    indice->entradas = novas;
+    indice->capacidade = nova_capacidade;
+    indice->quantidade = 0;
+    for (int i = 0; i < capacidade_antiga; i++) {
+        if (antigas[i].resultado) inserir_entrada_indice(indice, antigas[i].hash, antigas[i].resultado);
+    }
+    
+    free(antigas);
+    return 1;
+}
+
+static void indexar_nome(ArvoreResultados* arvore, ResultadoVotacao* resultado) {
+    IndiceNomes* indice = arvore->indice_nomes;
+    if (!indice) return;
+    
+    if ((indice->quantidade + 1) * 4 > indice->capacidade * 3 && !crescer_indice_nomes(indice)) {
+        // Sem memria para crescer: o ndice deixa de ser confivel
+        desativar_indice_nomes(arvore);
+        return;
+    }
+    inserir_entrada_indice(indice, hash_nome(resultado->nome), resultado);
+}
+
+// Remoo com deslocamento para trs: as entradas seguintes do mesmo
+// agrupamento voltam para perto da posio ideal, sem marcas de removido
+static void desindexar_nome(ArvoreResultados* arvore, ResultadoVotacao* resultado) {
+    IndiceNomes* indice = arvore->indice_nomes;
+    if (!indice) return;
+    
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    unsigned int i = hash_nome(resultado->nome) & mascara;
+    while (indice->entradas[i].resultado && indice->entradas[i].resultado != resultado) {
+        i = (i + 1) & mascara;
+    }
+    if (!indice->entradas[i].resultado) return;
+    
+    unsigned int vazio = i;
+    unsigned int j = i;
+    for (;;) {
+        j = (j + 1) & mascara;
+        if (!indice->entradas[j].resultado) break;
+        
+        // S move a entrada se a posio ideal dela no est entre vazio e j
+        unsigned int ideal = indice->entradas[j].hash & mascara;
+        if (((j - ideal) & mascara) >= ((j - vazio) & mascara)) {
+            indice->entradas[vazio] = indice->entradas[j];
+            vazio = j;
+        }
+    }
+    indice->entradas[vazio].resultado = NULL;
+    indice->quantidade--;
+}
+
+static ResultadoVotacao* buscar_indice_nomes(IndiceNomes* indice, const char* nome) {
+    unsigned int hash = hash_nome(nome);
+    unsigned int mascara = (unsigned int)indice->capacidade - 1;
+    
+    for (unsigned int i = hash & mascara; indice->entradas[i].resultado; i = (i + 1) & mascara) {
+        if (indice->entradas[i].hash == hash && strcmp(indice->entradas[i].resultado->nome, nome) == 0) {
+            return indice->entradas[i].resultado;
+        }
+    }
+    return NULL;
+}
+
+int ativar_indice_nomes(ArvoreResultados* arvore) {
+    if (!arvore) return 0;
+    if (arvore->indice_nomes) return 1;
+    
+    IndiceNomes* indice = (IndiceNomes*)malloc(sizeof(IndiceNomes));
+    if (!indice) return 0;
+    
+    // Capacidade j suficiente para os ns existentes
+    int capacidade = CAPACIDADE_INICIAL_INDICE_NOMES;
+    while (total_nos_arvore(arvore) * 4 > capacidade * 3) capacidade *= 2;
+    
+    indice->entradas = (EntradaIndiceNomes*)calloc(capacidade, sizeof(EntradaIndiceNomes));
+    if (!indice->entradas) {
+        free(indice);
+        return 0;
+    }
+    indice->capacidade = capacidade;
+    indice->quantidade = 0;
+    
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore->raiz, PERCURSO_PRE_ORDEM);
+    
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
+        inserir_entrada_indice(indice, hash_nome(resultado->nome), resultado);
+    }
+    
+    arvore->indice_nomes = indice;
+    return 1;
+}
+
+void desativar_indice_nomes(ArvoreResultados* arvore) {
+    if (!arvore || !arvore->indice_nomes) return;
+    
+    free(arvore->indice_nomes->entradas);
+    free(arvore->indice_nomes);
+    arvore->indice_nomes = NULL;
 }
@@ -56,6 +56,24 @@ void percurso_pos_ordem(NoArvoreResultados* raiz, void (*callback)(ResultadoVota
 void percurso_em_ordem_filtrado(NoArvoreResultados* raiz, TipoNoArvore tipo, 
                                void (*callback)(ResultadoVotacao*));
 
+// Iterador sem recurso
+// Prottipo da funo que posiciona o iterador na raiz com a ordem pedida
+void iniciar_iterador_arvore(IteradorArvore* it, NoArvoreResultados* raiz, OrdemPercurso ordem);
+// Prottipo da funo que restringe o iterador a um tipo de n
+void filtrar_iterador_arvore(IteradorArvore* it, TipoNoArvore tipo);
+// Prottipo da funo que devolve o prximo n (NULL no fim)
+NoArvoreResultados* proximo_no_iterador(IteradorArvore* it);
+// Prottipo da funo que devolve o prximo resultado (NULL no fim)
+ResultadoVotacao* proximo_resultado_iterador(IteradorArvore* it);
+
+// Percursos com contexto
+// Prottipo da funo de percurso que repassa um contexto ao callback
+void percorrer_arvore_resultados(NoArvoreResultados* raiz, OrdemPercurso ordem,
+                                 void (*callback)(ResultadoVotacao*, void*), void* contexto);
+// Prottipo da funo de percurso com contexto filtrado por tipo
+void percorrer_arvore_filtrado(NoArvoreResultados* raiz, OrdemPercurso ordem, TipoNoArvore tipo,
+                               void (*callback)(ResultadoVotacao*, void*), void* contexto);
+
 // ================= RVORE AVL (BALANCEAMENTO) =================
 
 // Funes de balanceamento
@@ -83,7 +101,8 @@ ResultadoVotacao criar_resultado_regiao(const char* regiao, int votos_regiao, in
 // Atualizao de resultados
 // Prottipo da funo que atualiza votos de um resultado
 int atualizar_votos_resultado(ArvoreResultados* arvore, int id, int votos_adicionais);
-// Prottipo da funo que atualiza percentuais da rvore
+// Prottipo da funo que atualiza percentuais da rvore (s refaz se houve
+// mudana de votos desde o ltimo clculo; leitores chamam antes de ler)
 int atualizar_percentuais_arvore(ArvoreResultados* arvore);
 
 // ================= ESTATSTICAS E CONSULTAS =================
@@ -91,6 +110,10 @@ int atualizar_percentuais_arvore(ArvoreResultados* arvore);
 // Consultas bsicas
 // Prottipo da funo que conta total de ns
 int total_nos_arvore(ArvoreResultados* arvore);
+// Prottipo da funo que retorna a soma dos votos de todos os ns
+int soma_votos_arvore(ArvoreResultados* arvore);
+// Prottipo da funo que soma os votos dos IDs em [id_min, id_max]
+int soma_votos_intervalo(ArvoreResultados* arvore, int id_min, int id_max);
 // Prottipo da funo que retorna altura da rvore
 int altura_arvore(ArvoreResultados* arvore);
 // Prottipo da funo que verifica se rvore est vazia
@@ -112,6 +135,24 @@ void candidatos_acima_de_limite(ArvoreResultados* arvore, int limite_votos);
 // Prottipo da funo que lista CAPs acima de limite de votos
 void caps_acima_de_limite(ArvoreResultados* arvore, int limite_votos);
 
+// As consultas abaixo usam o ndice de ranking: O(log n + k) para k
+// resultados, sempre do mais votado para o menos votado (empate pelo menor ID).
+// Para "acima de um limite" use votos_min = limite + 1 e votos_max = INT_MAX.
+// Prottipo da funo que conta os resultados com votos em [votos_min, votos_max] em O(log n)
+int contar_resultados_na_faixa(ArvoreResultados* arvore, int votos_min, int votos_max);
+// Prottipo da funo que retorna os resultados com votos em [votos_min, votos_max];
+// o array deve ser liberado com free e seu tamanho vai em *quantidade
+ResultadoVotacao** resultados_na_faixa(ArvoreResultados* arvore, int votos_min, int votos_max,
+                                       int* quantidade);
+// Prottipo da funo que posiciona o iterador no incio da faixa de votos
+void iniciar_iterador_faixa(IteradorFaixaVotos* it, ArvoreResultados* arvore,
+                            int votos_min, int votos_max);
+// Prottipo da funo que retorna o prximo resultado da faixa (NULL no fim)
+ResultadoVotacao* proximo_iterador_faixa(IteradorFaixaVotos* it);
+// Prottipo da funo que preenche at tamanho_pagina resultados e retorna
+// quantos vieram (0 = faixa esgotada)
+int proxima_pagina_faixa(IteradorFaixaVotos* it, ResultadoVotacao** pagina, int tamanho_pagina);
+
 // ================= VISUALIZAO E EXPORTAO =================
 
 // Exibio formatada
@@ -143,6 +184,48 @@ void ordenar_resultados_crescente(ArvoreResultados* arvore,
                                  ResultadoVotacao** array, int* indice);
 // Prottipo da funo que retorna array de resultados ordenados
 ResultadoVotacao** obter_resultados_ordenados(ArvoreResultados* arvore, int ordem);
+// Prottipo da funo que retorna os k mais votados (empate pelo menor ID);
+// o array deve ser liberado com free e seu tamanho vai em *quantidade
+ResultadoVotacao** obter_top_resultados(ArvoreResultados* arvore, int k, int* quantidade);
+
+// ================= CARGA EM LOTE =================
+
+// Prottipo da funo que monta a rvore inteira de uma vez: a rvore por ID
+// sai em O(n) se os resultados vierem ordenados por ID (seno ordena antes) e
+// o ranking pede uma ordenao por votos. IDs repetidos somam votos como na
+// insero. As duas rvores saem perfeitamente balanceadas, com os ns num
+// s bloco; o ndice de nomes no  ativado. Retorna NULL sem memria.
+ArvoreResultados* construir_arvore_resultados(TipoNoArvore tipo, ResultadoVotacao* resultados,
+                                              int quantidade);
+
+// ================= NDICE DE NOMES =================
+
+// Prottipo da funo que passa a manter o ndice nome -> resultado
+// (a busca por nome fica O(1)); indexa os ns j existentes
+int ativar_indice_nomes(ArvoreResultados* arvore);
+// Prottipo da funo que descarta o ndice de nomes (volta  busca linear)
+void desativar_indice_nomes(ArvoreResultados* arvore);
+
+// ================= NDICE DE RANKING =================
+
+// Prottipo da funo que retorna a posio (1 = mais votado) de um ID, ou 0
+int posicao_ranking(ArvoreResultados* arvore, int id);
+// Prottipo da funo que retorna o resultado na posio N do ranking
+ResultadoVotacao* resultado_na_posicao(ArvoreResultados* arvore, int posicao);
+
+// ================= LDER E SEGUNDO COLOCADO =================
+
+// Mantidos a cada voto; as consultas abaixo so O(1) e valem para qualquer
+// tipo de rvore (empate fica com o menor ID)
+// Prottipo da funo que retorna o primeiro colocado (NULL se vazia)
+ResultadoVotacao* lider_arvore(ArvoreResultados* arvore);
+// Prottipo da funo que retorna o segundo colocado (NULL se houver menos de dois)
+ResultadoVotacao* segundo_colocado_arvore(ArvoreResultados* arvore);
+// Prottipo da funo que retorna o ltimo colocado (NULL se vazia)
+ResultadoVotacao* ultimo_colocado_arvore(ArvoreResultados* arvore);
+// Prottipo da funo que retorna a diferena de votos entre o primeiro e o
+// segundo colocados (os votos do lder, se ele estiver sozinho)
+int margem_vitoria_arvore(ArvoreResultados* arvore);
 
 // Fim da diretiva de pr-processador
 #endif
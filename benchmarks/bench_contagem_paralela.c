@@ -0,0 +1,127 @@
+// Benchmark da contagem paralela dos histricos das urnas
+// (contar_votos_urnas_paralelo): votos por segundo com 1, 2, 4 e 8 threads,
+// 30 candidatos e 20 CAPs com 10 urnas cada, 4 milhes de votos por padro.
+// Cerca de 1% dos votos vai para nmeros fora do cadastro. Cada contagem 
+// comparada com a contagem sequencial feita ao gerar os votos. O ganho com
+// mais threads depende de haver processadores livres: o programa mostra
+// quantos o sistema oferece.
+//
+// Compilar (na raiz do projeto):
+//   gcc -O2 -std=c99 -pthread -I. -o bench_contagem_paralela benchmarks/bench_contagem_paralela.c
+//       apuracao_paralela.c pilhas.c crc32c.c diario_operacoes.c -lm
+// Executar: ./bench_contagem_paralela [num_votos] [repeticoes]   (padro 4000000 e 5)
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "apuracao_paralela.h"
+#include "pilhas.h"
+
+#define NUM_CANDIDATOS 30
+#define NUM_CAPS 20
+#define URNAS_POR_CAP 10
+
+static double agora_ms() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+static int conferir(ContagemVotos* contagem, int* esperado_candidatos,
+                    long long contados, long long ignorados) {
+    if (contagem->votos_contados != contados || contagem->votos_ignorados != ignorados) return 0;
+    for (int i = 0; i < NUM_CANDIDATOS; i++) {
+        if (contagem->votos_candidatos[i] != esperado_candidatos[i]) return 0;
+    }
+    // A contagem das urnas no separa por CAP
+    return contagem->num_caps == 0 && contagem->votos_caps == NULL;
+}
+
+int main(int argc, char** argv) {
+    int num_votos = argc > 1 ? atoi(argv[1]) : 4000000;
+    int repeticoes = argc > 2 ? atoi(argv[2]) : 5;
+    srand(2026);
+    
+    ListaCandidatos candidatos;
+    candidatos.candidatos = (Candidato*)calloc(NUM_CANDIDATOS, sizeof(Candidato));
+    candidatos.tamanho = candidatos.capacidade = NUM_CANDIDATOS;
+    for (int i = 0; i < NUM_CANDIDATOS; i++) {
+        candidatos.candidatos[i].numero = 10 + i;
+        snprintf(candidatos.candidatos[i].nome, MAX_NOME, "Candidato %d", i);
+    }
+    
+    ListaCAPs caps;
+    memset(&caps, 0, sizeof(ListaCAPs));
+    caps.caps = (CAP*)calloc(NUM_CAPS, sizeof(CAP));
+    caps.tamanho = caps.capacidade = NUM_CAPS;
+    for (int i = 0; i < NUM_CAPS; i++) {
+        CAP* cap = &caps.caps[i];
+        cap->id = i + 1;
+        cap->num_urnas = URNAS_POR_CAP;
+        cap->urnas = (Urna**)calloc(URNAS_POR_CAP, sizeof(Urna*));
+        for (int j = 0; j < URNAS_POR_CAP; j++) {
+            cap->urnas[j] = (Urna*)calloc(1, sizeof(Urna));
+            cap->urnas[j]->numero = j + 1;
+            cap->urnas[j]->cap_id = cap->id;
+            cap->urnas[j]->historico_votos = criar_pilha_votos();
+        }
+    }
+    
+    // Votos sorteados, contados sequencialmente para a conferncia
+    int esperado_candidatos[NUM_CANDIDATOS] = {0};
+    long long contados = 0, ignorados = 0;
+    for (int v = 0; v < num_votos; v++) {
+        int c = rand() % NUM_CAPS;
+        Urna* urna = caps.caps[c].urnas[rand() % URNAS_POR_CAP];
+        int posicao = rand() % NUM_CANDIDATOS;
+        int numero = rand() % 100 == 0 ? 99 : candidatos.candidatos[posicao].numero;
+        if (!empilhar_voto(urna->historico_votos, criar_voto(v, numero, urna->cap_id, urna->numero))) {
+            printf("Sem memoria para os votos!\n");
+            return 1;
+        }
+        if (numero == 99) {
+            ignorados++;
+        } else {
+            esperado_candidatos[posicao]++;
+            contados++;
+        }
+    }
+    
+    printf("Processadores disponiveis: %d\n", threads_disponiveis());
+    printf("%d votos, %d candidatos, %d CAPs x %d urnas, melhor de %d\n\n",
+           num_votos, NUM_CANDIDATOS, NUM_CAPS, URNAS_POR_CAP, repeticoes);
+    printf("%-8s %12s %14s\n", "threads", "tempo (ms)", "Mvotos/s");
+    
+    int falhas = 0;
+    for (int threads = 1; threads <= 8; threads *= 2) {
+        double melhor = -1;
+        for (int r = 0; r < repeticoes; r++) {
+            ContagemVotos contagem;
+            double inicio = agora_ms();
+            int ok = contar_votos_urnas_paralelo(&candidatos, &caps, threads, &contagem);
+            double tempo = agora_ms() - inicio;
+            if (!ok || !conferir(&contagem, esperado_candidatos, contados, ignorados)) {
+                printf("ERRO: contagem com %d threads nao bate com a sequencial\n", threads);
+                falhas++;
+            }
+            liberar_contagem_votos(&contagem);
+            if (melhor < 0 || tempo < melhor) melhor = tempo;
+        }
+        printf("%-8d %12.2f %14.1f\n", threads, melhor, num_votos / melhor / 1e3);
+    }
+    
+    for (int i = 0; i < NUM_CAPS; i++) {
+        for (int j = 0; j < URNAS_POR_CAP; j++) {
+            destruir_pilha_votos(caps.caps[i].urnas[j]->historico_votos);
+            free(caps.caps[i].urnas[j]);
+        }
+        free(caps.caps[i].urnas);
+    }
+    free(caps.caps);
+    free(candidatos.candidatos);
+    
+    if (falhas) return 1;
+    printf("\nContagens conferidas com a contagem sequencial.\n");
+    return 0;
+}
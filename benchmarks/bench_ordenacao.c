@@ -0,0 +1,112 @@
+// Benchmark do ranking: ordenao por bolha (cdigo antigo de
+// ordenar_resultados_decrescente), qsort de obter_resultados_ordenados e
+// seleo parcial de obter_top_resultados.
+//
+// Compilar (na raiz do projeto):
+//   gcc -O2 -std=c99 -pthread -I. -o bench_ordenacao benchmarks/bench_ordenacao.c
+//       arvore_resultados.c escritor_saida.c -lm
+// Executar: ./bench_ordenacao [maior_n_da_bolha]   (padro 10000)
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "arvore_resultados.h"
+
+#define TOP_K 20
+
+static double agora_ms() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+// IDs 1..n inseridos em ordem aleatria, votos aleatrios em 0..4999
+static ArvoreResultados* montar_arvore(int n) {
+    ArvoreResultados* arvore = criar_arvore_resultados(TIPO_CANDIDATO);
+    int* ids = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) ids[i] = i + 1;
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = ids[i]; ids[i] = ids[j]; ids[j] = t;
+    }
+    
+    for (int i = 0; i < n; i++) {
+        ResultadoVotacao resultado;
+        memset(&resultado, 0, sizeof(ResultadoVotacao));
+        resultado.id = ids[i];
+        snprintf(resultado.nome, MAX_NOME, "Candidato %d", ids[i]);
+        resultado.tipo = TIPO_CANDIDATO;
+        resultado.votos = rand() % 5000;
+        inserir_resultado_arvore(arvore, resultado);
+    }
+    free(ids);
+    return arvore;
+}
+
+// Ordenao por bolha do cdigo anterior, sobre a coleta em ordem de ID
+static ResultadoVotacao** ordenar_bolha(ArvoreResultados* arvore, int n) {
+    ResultadoVotacao** array = obter_resultados_ordenados(arvore, 0);
+    for (int i = 0; i < n - 1; i++) {
+        for (int j = 0; j < n - i - 1; j++) {
+            if (array[j]->votos < array[j + 1]->votos) {
+                ResultadoVotacao* temp = array[j];
+                array[j] = array[j + 1];
+                array[j + 1] = temp;
+            }
+        }
+    }
+    return array;
+}
+
+// Votos decrescentes e, no empate, ID crescente
+static int ranking_correto(ResultadoVotacao** array, int n) {
+    for (int i = 1; i < n; i++) {
+        if (array[i - 1]->votos < array[i]->votos) return 0;
+        if (array[i - 1]->votos == array[i]->votos && array[i - 1]->id > array[i]->id) return 0;
+    }
+    return 1;
+}
+
+int main(int argc, char** argv) {
+    int limite_bolha = argc > 1 ? atoi(argv[1]) : 10000;
+    int tamanhos[] = { 1000, 10000, 50000, 100000 };
+    int falhas = 0;
+    srand(2026);
+    
+    printf("%8s %12s %12s %12s\n", "n", "bolha", "qsort", "top-20");
+    for (int t = 0; t < (int)(sizeof(tamanhos) / sizeof(tamanhos[0])); t++) {
+        int n = tamanhos[t];
+        ArvoreResultados* arvore = montar_arvore(n);
+        
+        char bolha[32] = "-";
+        if (n <= limite_bolha) {
+            double inicio = agora_ms();
+            ResultadoVotacao** array = ordenar_bolha(arvore, n);
+            snprintf(bolha, sizeof(bolha), "%.2f ms", agora_ms() - inicio);
+            free(array);
+        }
+        
+        double inicio = agora_ms();
+        ResultadoVotacao** ordenados = obter_resultados_ordenados(arvore, 1);
+        double tempo_qsort = agora_ms() - inicio;
+        
+        int quantidade = 0;
+        inicio = agora_ms();
+        ResultadoVotacao** top = obter_top_resultados(arvore, TOP_K, &quantidade);
+        double tempo_top = agora_ms() - inicio;
+        
+        // O top-k tem de ser o comeo do ranking completo
+        int ok = ranking_correto(ordenados, n) && quantidade == (n < TOP_K ? n : TOP_K);
+        for (int i = 0; ok && i < quantidade; i++) ok = (top[i] == ordenados[i]);
+        if (!ok) falhas++;
+        
+        printf("%8d %12s %9.2f ms %9.3f ms%s\n", n, bolha, tempo_qsort, tempo_top,
+               ok ? "" : "  ERRO");
+        free(ordenados);
+        free(top);
+        destruir_arvore_resultados(arvore);
+    }
+    
+    return falhas ? 1 : 0;
+}
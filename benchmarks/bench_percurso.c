@@ -0,0 +1,139 @@
+// Benchmark dos percursos da rvore de resultados: recurso com ponteiro
+// de funo (referncia), iterador com pilha explcita em lao prprio e
+// percurso com callback e contexto, sobre cerca de um milho de ns.
+//
+// Compilar (na raiz do projeto):
+//   gcc -O2 -std=c99 -pthread -I. -o bench_percurso benchmarks/bench_percurso.c
+//       arvore_resultados.c escritor_saida.c -lm
+// Executar: ./bench_percurso [num_nos] [repeticoes]   (padro 1000000 e 7)
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "arvore_resultados.h"
+
+static double agora_ms() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+// IDs 1..n inseridos em ordem aleatria: os ns ficam espalhados pela
+// memria como numa apurao real
+static ArvoreResultados* montar_arvore(int n) {
+    ArvoreResultados* arvore = criar_arvore_resultados(TIPO_CANDIDATO);
+    int* ids = (int*)malloc(n * sizeof(int));
+    for (int i = 0; i < n; i++) ids[i] = i + 1;
+    for (int i = n - 1; i > 0; i--) {
+        int j = rand() % (i + 1);
+        int t = ids[i]; ids[i] = ids[j]; ids[j] = t;
+    }
+    
+    ResultadoVotacao resultado;
+    memset(&resultado, 0, sizeof(ResultadoVotacao));
+    resultado.tipo = TIPO_CANDIDATO;
+    for (int i = 0; i < n; i++) {
+        resultado.id = ids[i];
+        resultado.votos = rand() % 1000;
+        inserir_resultado_arvore(arvore, resultado);
+    }
+    free(ids);
+    return arvore;
+}
+
+static long long soma;
+
+static void somar(ResultadoVotacao* resultado) {
+    soma += resultado->votos;
+}
+
+static void somar_contexto(ResultadoVotacao* resultado, void* contexto) {
+    *(long long*)contexto += resultado->votos;
+}
+
+// Referncia: o percurso recursivo que o cdigo usava antes. Sem noipa o
+// GCC especializa a cpia para somar() e tira a chamada indireta, que a
+// funo exportada antiga sempre pagava
+__attribute__((noipa))
+static void em_ordem_recursivo(NoArvoreResultados* no, void (*callback)(ResultadoVotacao*)) {
+    if (!no) return;
+    em_ordem_recursivo(no->esquerda, callback);
+    callback(&no->resultado);
+    em_ordem_recursivo(no->direita, callback);
+}
+
+static long long somar_iterador(NoArvoreResultados* raiz, OrdemPercurso ordem) {
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, raiz, ordem);
+    long long total = 0;
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL) {
+        total += resultado->votos;
+    }
+    return total;
+}
+
+int main(int argc, char** argv) {
+    int n = argc > 1 ? atoi(argv[1]) : 1000000;
+    int repeticoes = argc > 2 ? atoi(argv[2]) : 7;
+    srand(2026);
+    
+    ArvoreResultados* arvore = montar_arvore(n);
+    long long esperado = soma_votos_arvore(arvore);
+    double melhor[6] = { 1e18, 1e18, 1e18, 1e18, 1e18, 1e18 };
+    const char* nomes[6] = {
+        "recursao + ponteiro de funcao", "iterador em ordem", "iterador pre-ordem",
+        "iterador pos-ordem", "callback + contexto", "percurso_em_ordem"
+    };
+    int falhas = 0;
+    
+    for (int r = 0; r < repeticoes; r++) {
+        long long obtido[6];
+        double inicio;
+        
+        inicio = agora_ms();
+        soma = 0;
+        em_ordem_recursivo(arvore->raiz, somar);
+        obtido[0] = soma;
+        double tempos[6];
+        tempos[0] = agora_ms() - inicio;
+        
+        inicio = agora_ms();
+        obtido[1] = somar_iterador(arvore->raiz, PERCURSO_EM_ORDEM);
+        tempos[1] = agora_ms() - inicio;
+        
+        inicio = agora_ms();
+        obtido[2] = somar_iterador(arvore->raiz, PERCURSO_PRE_ORDEM);
+        tempos[2] = agora_ms() - inicio;
+        
+        inicio = agora_ms();
+        obtido[3] = somar_iterador(arvore->raiz, PERCURSO_POS_ORDEM);
+        tempos[3] = agora_ms() - inicio;
+        
+        inicio = agora_ms();
+        obtido[4] = 0;
+        percorrer_arvore_resultados(arvore->raiz, PERCURSO_EM_ORDEM, somar_contexto, &obtido[4]);
+        tempos[4] = agora_ms() - inicio;
+        
+        inicio = agora_ms();
+        soma = 0;
+        percurso_em_ordem(arvore->raiz, somar);
+        obtido[5] = soma;
+        tempos[5] = agora_ms() - inicio;
+        
+        for (int i = 0; i < 6; i++) {
+            if (obtido[i] != esperado) falhas++;
+            if (tempos[i] < melhor[i]) melhor[i] = tempos[i];
+        }
+    }
+    
+    printf("%d nos, melhor de %d execucoes\n", n, repeticoes);
+    for (int i = 0; i < 6; i++) {
+        printf("  %-32s %8.2f ms  %6.2f ns/no\n", nomes[i], melhor[i], melhor[i] * 1e6 / n);
+    }
+    if (falhas) printf("ERRO: %d somas diferentes de %lld\n", falhas, esperado);
+    
+    destruir_arvore_resultados(arvore);
+    return falhas ? 1 : 0;
+}
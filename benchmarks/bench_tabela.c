@@ -0,0 +1,174 @@
+// Benchmark da TabelaResultados contra a ArvoreResultados (AVL): busca por
+// ID em ordem aleatria e +1 voto, com 100 mil chaves por padro. Antes de
+// medir, as duas estruturas passam pela mesma sequncia de inseres, IDs
+// repetidos, remoes e votos, e o ranking, os nomes, os percentuais e as
+// buscas das duas so comparados.
+//
+// Compilar (na raiz do projeto):
+//   gcc -O2 -std=c99 -pthread -I. -o bench_tabela benchmarks/bench_tabela.c
+//       arvore_resultados.c tabela_resultados.c escritor_saida.c -lm
+// Executar: ./bench_tabela [num_chaves] [repeticoes]   (padro 100000 e 5)
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "arvore_resultados.h"
+#include "tabela_resultados.h"
+
+#define NUM_CONSULTAS 2000000
+#define NUM_VOTOS 200000            // A AVL leva alguns s por voto
+
+static double agora_ms() {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec / 1e6;
+}
+
+static int mesmo_resultado(ResultadoVotacao* a, ResultadoVotacao* b) {
+    float diferenca = a->percentual - b->percentual;
+    return a->id == b->id && a->votos == b->votos && strcmp(a->nome, b->nome) == 0 &&
+           diferenca < 1e-3f && diferenca > -1e-3f;
+}
+
+// Cerca de num_chaves IDs distintos sorteados em 0..4*num_chaves, com IDs
+// repetidos (somam votos), remoes e votos extras no meio
+static int* montar(ArvoreResultados* arvore, TabelaResultados* tabela, int num_chaves) {
+    int* ids = (int*)malloc(num_chaves * sizeof(int));
+    int faixa = 4 * num_chaves;
+    int i = 0;
+    
+    while (total_nos_arvore(arvore) < num_chaves) {
+        ResultadoVotacao resultado;
+        memset(&resultado, 0, sizeof(ResultadoVotacao));
+        resultado.id = rand() % faixa;
+        resultado.tipo = TIPO_CAP;
+        resultado.votos = rand() % 500;
+        snprintf(resultado.nome, MAX_NOME, "CAP %d", resultado.id);
+        inserir_resultado_arvore(arvore, resultado);
+        inserir_resultado_tabela(tabela, resultado);
+        ids[i++ % num_chaves] = resultado.id;
+        
+        if (i % 97 == 0) {
+            int id = rand() % faixa;
+            remover_resultado_arvore(arvore, id);
+            remover_resultado_tabela(tabela, id);
+        }
+        if (i % 13 == 0) {
+            int id = rand() % faixa;
+            atualizar_votos_resultado(arvore, id, 3);
+            atualizar_votos_resultado_tabela(tabela, id, 3);
+        }
+    }
+    return ids;
+}
+
+static int conferir(ArvoreResultados* arvore, TabelaResultados* tabela, int faixa) {
+    int n = total_nos_arvore(arvore);
+    if (total_nos_tabela(tabela) != n || soma_votos_tabela(tabela) != soma_votos_arvore(arvore)) return 0;
+    
+    ResultadoVotacao** esperado = obter_resultados_ordenados(arvore, 1);
+    ResultadoVotacao** obtido = obter_resultados_ordenados_tabela(tabela, 1);
+    int ok = esperado && obtido;
+    for (int i = 0; ok && i < n; i++) ok = mesmo_resultado(esperado[i], obtido[i]);
+    free(esperado);
+    free(obtido);
+    
+    for (int id = 0; ok && id < faixa; id += 7) {
+        ResultadoVotacao* a = buscar_resultado_por_id(arvore, id);
+        ResultadoVotacao* b = buscar_resultado_por_id_tabela(tabela, id);
+        ok = (!a == !b) && (!a || mesmo_resultado(a, b));
+    }
+    return ok;
+}
+
+// O ponteiro devolvido pela tabela segue vlido e em dia depois de
+// inseres que fazem o pool crescer e de o layout ser refeito
+static int vistas_estaveis() {
+    TabelaResultados* tabela = criar_tabela_resultados(TIPO_CAP);
+    ResultadoVotacao resultado;
+    memset(&resultado, 0, sizeof(ResultadoVotacao));
+    resultado.tipo = TIPO_CAP;
+    resultado.id = 7;
+    resultado.votos = 10;
+    strcpy(resultado.nome, "CAP 7");
+    inserir_resultado_tabela(tabela, resultado);
+    
+    ResultadoVotacao* vista = buscar_resultado_por_id_tabela(tabela, 7);
+    for (int id = 100; id < 5000; id++) {
+        resultado.id = id;
+        resultado.votos = 1;
+        inserir_resultado_tabela(tabela, resultado);
+    }
+    atualizar_votos_resultado_tabela(tabela, 7, 5);
+    atualizar_percentuais_tabela(tabela);
+    
+    int ok = vista && buscar_resultado_por_id_tabela(tabela, 7) == vista && vista->votos == 15 &&
+             strcmp(vista->nome, "CAP 7") == 0 && vista->percentual > 0.0f;
+    destruir_tabela_resultados(tabela);
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    int num_chaves = argc > 1 ? atoi(argv[1]) : 100000;
+    int repeticoes = argc > 2 ? atoi(argv[2]) : 5;
+    srand(2026);
+    
+    ArvoreResultados* arvore = criar_arvore_resultados(TIPO_CAP);
+    TabelaResultados* tabela = criar_tabela_resultados(TIPO_CAP);
+    int* ids = montar(arvore, tabela, num_chaves);
+    
+    int falhas = 0;
+    if (!conferir(arvore, tabela, 4 * num_chaves)) falhas++;
+    if (!vistas_estaveis()) falhas++;
+    
+    // Consultas sorteadas entre as chaves presentes
+    int* consultas = (int*)malloc(NUM_CONSULTAS * sizeof(int));
+    for (int i = 0; i < NUM_CONSULTAS; i++) consultas[i] = ids[rand() % num_chaves];
+    
+    double melhor_arvore = 1e18, melhor_tabela = 1e18;
+    long long soma_arvore = 0, soma_tabela = 0;
+    for (int r = 0; r < repeticoes; r++) {
+        soma_arvore = soma_tabela = 0;
+        
+        double inicio = agora_ms();
+        for (int i = 0; i < NUM_CONSULTAS; i++) {
+            ResultadoVotacao* resultado = buscar_resultado_por_id(arvore, consultas[i]);
+            if (resultado) soma_arvore += resultado->votos;
+        }
+        double tempo = agora_ms() - inicio;
+        if (tempo < melhor_arvore) melhor_arvore = tempo;
+        
+        inicio = agora_ms();
+        for (int i = 0; i < NUM_CONSULTAS; i++) {
+            ResultadoVotacao* resultado = buscar_resultado_por_id_tabela(tabela, consultas[i]);
+            if (resultado) soma_tabela += resultado->votos;
+        }
+        tempo = agora_ms() - inicio;
+        if (tempo < melhor_tabela) melhor_tabela = tempo;
+    }
+    if (soma_arvore != soma_tabela) falhas++;
+    
+    // +1 voto (a rvore tambm reposiciona o ndice de ranking)
+    double inicio = agora_ms();
+    for (int i = 0; i < NUM_VOTOS; i++) atualizar_votos_resultado(arvore, consultas[i], 1);
+    double voto_arvore = agora_ms() - inicio;
+    inicio = agora_ms();
+    for (int i = 0; i < NUM_VOTOS; i++) atualizar_votos_resultado_tabela(tabela, consultas[i], 1);
+    double voto_tabela = agora_ms() - inicio;
+    if (!conferir(arvore, tabela, 4 * num_chaves)) falhas++;
+    
+    printf("%d chaves, %d consultas, melhor de %d\n", num_chaves, NUM_CONSULTAS, repeticoes);
+    printf("  %-22s %8s %8s\n", "", "AVL", "tabela");
+    printf("  %-22s %5.0f ns %5.0f ns\n", "busca por ID",
+           melhor_arvore * 1e6 / NUM_CONSULTAS, melhor_tabela * 1e6 / NUM_CONSULTAS);
+    printf("  %-22s %5.0f ns %5.0f ns\n", "+1 voto",
+           voto_arvore * 1e6 / NUM_VOTOS, voto_tabela * 1e6 / NUM_VOTOS);
+    if (falhas) printf("ERRO: %d verificacoes falharam\n", falhas);
+    
+    free(consultas);
+    free(ids);
+    destruir_tabela_resultados(tabela);
+    destruir_arvore_resultados(arvore);
+    return falhas ? 1 : 0;
+}
@@ -3,11 +3,14 @@
 #include <string.h>
 #include "caps.h"
 #include "filas.h"  // Adicionar esta linha
+#include "votacao.h"
 
 void inicializar_lista_caps(ListaCAPs* lista, int capacidade) {
     lista->caps = (CAP*)malloc(capacidade * sizeof(CAP));
     lista->tamanho = 0;
     lista->capacidade = capacidade;
+    // Sem pendncias a apurao sempre refaz tudo
+    lista->pendencias = (PendenciasApuracao*)calloc(1, sizeof(PendenciasApuracao));
 }
 
 int inserir_cap(ListaCAPs* lista, CAP novo_cap) {
@@ -31,8 +34,12 @@ int inserir_cap(ListaCAPs* lista, CAP novo_cap) {
     // Inicializar filas (usando a nova estrutura)
     novo_cap.fila_normal = criar_fila();
     novo_cap.fila_prioritaria = criar_fila();
+    inicializar_atendimento_cap(&novo_cap);
     novo_cap.urnas = NULL; // Ser alocado quando necessrio
     novo_cap.resultados_cap = NULL;
+    novo_cap.pendencias = lista->pendencias;
+    novo_cap.posicao = lista->tamanho;
+    novo_cap.pendente = false;
     
     // Inserir
     lista->caps[lista->tamanho] = novo_cap;
@@ -51,14 +58,13 @@ int remover_cap_por_id(ListaCAPs* lista, int id) {
             if (lista->caps[i].fila_prioritaria) {
                 destruir_fila(lista->caps[i].fila_prioritaria);
             }
+            // Liberar histogramas de espera
+            liberar_atendimento_cap(&lista->caps[i]);
             
             // Liberar urnas se existirem
             if (lista->caps[i].urnas) {
                 for (int j = 0; j < lista->caps[i].num_urnas; j++) {
-                    if (lista->caps[i].urnas[j]) {
-                        // Destruir urna se tivssemos a funo
-                        free(lista->caps[i].urnas[j]);
-                    }
+                    destruir_urna(lista->caps[i].urnas[j]);
                 }
                 free(lista->caps[i].urnas);
             }
@@ -72,8 +78,11 @@ int remover_cap_por_id(ListaCAPs* lista, int id) {
             // Mover elementos para preencher o espao
             for (int j = i; j < lista->tamanho - 1; j++) {
                 lista->caps[j] = lista->caps[j + 1];
+                lista->caps[j].posicao = j;
             }
             lista->tamanho--;
+            // As posies pendentes deixaram de valer
+            if (lista->pendencias) lista->pendencias->invalida = true;
             return 1;
         }
     }
@@ -150,18 +159,24 @@ void liberar_lista_caps(ListaCAPs* lista) {
         if (lista->caps[i].fila_prioritaria) {
             destruir_fila(lista->caps[i].fila_prioritaria);
         }
+        // Liberar histogramas de espera
+        liberar_atendimento_cap(&lista->caps[i]);
         
         // Liberar urnas
         if (lista->caps[i].urnas) {
             for (int j = 0; j < lista->caps[i].num_urnas; j++) {
-                if (lista->caps[i].urnas[j]) {
-                    free(lista->caps[i].urnas[j]);
-                }
+                destruir_urna(lista->caps[i].urnas[j]);
             }
             free(lista->caps[i].urnas);
         }
     }
     
+    if (lista->pendencias) {
+        free(lista->pendencias->caps);
+        free(lista->pendencias);
+        lista->pendencias = NULL;
+    }
+    
     free(lista->caps);
     lista->caps = NULL;
     lista->tamanho = 0;
@@ -178,6 +193,46 @@ void redimensionar_lista_caps(ListaCAPs* lista, int nova_capacidade) {
     }
 }
 
+void marcar_cap_pendente(CAP* cap) {
+    if (!cap || !cap->pendencias || cap->pendente) return;
+    
+    PendenciasApuracao* pendencias = cap->pendencias;
+    if (pendencias->quantidade >= pendencias->capacidade) {
+        int nova_capacidade = pendencias->capacidade > 0 ? pendencias->capacidade * 2 : 8;
+        int* novas = (int*)realloc(pendencias->caps, nova_capacidade * sizeof(int));
+        if (!novas) {
+            // Sem memria o CAP se perderia: a prxima apurao refaz tudo
+            pendencias->invalida = true;
+            return;
+        }
+        pendencias->caps = novas;
+        pendencias->capacidade = nova_capacidade;
+    }
+    
+    pendencias->caps[pendencias->quantidade++] = cap->posicao;
+    cap->pendente = true;
+}
+
+void limpar_pendencias_caps(ListaCAPs* lista, const void* dono) {
+    if (!lista || !lista->pendencias) return;
+    
+    PendenciasApuracao* pendencias = lista->pendencias;
+    if (pendencias->invalida) {
+        // Posies perdidas: desmarca todos os CAPs
+        for (int i = 0; i < lista->tamanho; i++) {
+            lista->caps[i].pendente = false;
+        }
+    } else {
+        for (int i = 0; i < pendencias->quantidade; i++) {
+            lista->caps[pendencias->caps[i]].pendente = false;
+        }
+    }
+    
+    pendencias->quantidade = 0;
+    pendencias->invalida = false;
+    pendencias->dono = dono;
+}
+
 int total_capacidade_eleitores(ListaCAPs* lista) {
     int total = 0;
     for (int i = 0; i < lista->tamanho; i++) {
@@ -41,6 +41,14 @@ void liberar_lista_caps(ListaCAPs* lista);
 // Prottipo da funo que redimensiona lista de CAPs
 void redimensionar_lista_caps(ListaCAPs* lista, int nova_capacidade);
 
+// Apurao incremental
+// Prottipo da funo que pe o CAP nas pendncias da prxima apurao
+// (chamada a cada eleitor atendido e a cada voto)
+void marcar_cap_pendente(CAP* cap);
+// Prottipo da funo que esvazia as pendncias depois de uma apurao
+// feita pelo sistema dono
+void limpar_pendencias_caps(ListaCAPs* lista, const void* dono);
+
 // Estatsticas
 // Prottipo da funo que calcula capacidade total de eleitores
 int total_capacidade_eleitores(ListaCAPs* lista);
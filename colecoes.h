@@ -0,0 +1,208 @@
+#ifndef COLECOES_H
+#define COLECOES_H
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+
+// ================= CONTINERES TIPADOS (GERADOS POR MACRO) =================
+//
+// Cada macro gera a estrutura e as funes (static inline) para um tipo de
+// elemento. Os elementos ficam por valor num array contguo, sem n por
+// elemento. As funes recebem o sufixo como nome: DEFINIR_PILHA(PilhaX, X, pilha_x)
+// gera criar_pilha_x, empilhar_pilha_x, topo_pilha_x, etc.
+// Ponteiros para elementos valem at a prxima insero (o array pode crescer).
+
+#define CAPACIDADE_INICIAL_COLECAO 8
+
+// Prxima capacidade ao crescer: a inicial ou o dobro; 0 quando o dobro
+// no cabe em int (o continer no cresce mais)
+static inline int proxima_capacidade_colecao(int capacidade) {
+    if (capacidade == 0) return CAPACIDADE_INICIAL_COLECAO;
+    return capacidade <= INT_MAX / 2 ? capacidade * 2 : 0;
+}
+
+// Vetor dinmico: insero no fim e acesso por ndice (0 = primeiro inserido)
+#define DEFINIR_VETOR(Nome, Tipo, sufixo)                                       \
+    typedef struct Nome {                                                       \
+        Tipo* itens;                                                            \
+        int tamanho;                                                            \
+        int capacidade;                                                         \
+    } Nome;                                                                     \
+                                                                                \
+    static inline void iniciar_##sufixo(Nome* colecao) {                        \
+        colecao->itens = NULL;                                                  \
+        colecao->tamanho = 0;                                                   \
+        colecao->capacidade = 0;                                                \
+    }                                                                           \
+                                                                                \
+    static inline void liberar_##sufixo(Nome* colecao) {                        \
+        free(colecao->itens);                                                   \
+        iniciar_##sufixo(colecao);                                              \
+    }                                                                           \
+                                                                                \
+    static inline Nome* criar_##sufixo() {                                      \
+        Nome* colecao = (Nome*)malloc(sizeof(Nome));                            \
+        if (colecao) iniciar_##sufixo(colecao);                                 \
+        return colecao;                                                         \
+    }                                                                           \
+                                                                                \
+    static inline void destruir_##sufixo(Nome* colecao) {                       \
+        if (!colecao) return;                                                   \
+        free(colecao->itens);                                                   \
+        free(colecao);                                                          \
+    }                                                                           \
+                                                                                \
+    static inline int reservar_##sufixo(Nome* colecao, int capacidade) {        \
+        if (capacidade <= colecao->capacidade) return 1;                        \
+        Tipo* novos = (Tipo*)realloc(colecao->itens, capacidade * sizeof(Tipo)); \
+        if (!novos) return 0;                                                   \
+        colecao->itens = novos;                                                 \
+        colecao->capacidade = capacidade;                                       \
+        return 1;                                                               \
+    }                                                                           \
+                                                                                \
+    static inline int anexar_##sufixo(Nome* colecao, Tipo item) {               \
+        if (colecao->tamanho == colecao->capacidade) {                          \
+            int capacidade = proxima_capacidade_colecao(colecao->capacidade);   \
+            if (!capacidade || !reservar_##sufixo(colecao, capacidade)) return 0;\
+        }                                                                       \
+        colecao->itens[colecao->tamanho++] = item;                              \
+        return 1;                                                               \
+    }                                                                           \
+                                                                                \
+    static inline int remover_ultimo_##sufixo(Nome* colecao, Tipo* saida) {     \
+        if (colecao->tamanho == 0) return 0;                                    \
+        colecao->tamanho--;                                                     \
+        if (saida) *saida = colecao->itens[colecao->tamanho];                   \
+        return 1;                                                               \
+    }                                                                           \
+                                                                                \
+    static inline Tipo* elemento_##sufixo(Nome* colecao, int indice) {          \
+        if (!colecao || indice < 0 || indice >= colecao->tamanho) return NULL;  \
+        return &colecao->itens[indice];                                         \
+    }                                                                           \
+                                                                                \
+    static inline int tamanho_##sufixo(const Nome* colecao) {                   \
+        return colecao ? colecao->tamanho : 0;                                  \
+    }                                                                           \
+                                                                                \
+    static inline bool vazia_##sufixo(const Nome* colecao) {                    \
+        return !colecao || colecao->tamanho == 0;                               \
+    }
+
+// Pilha (LIFO) sobre o vetor: elemento 0  a base
+#define DEFINIR_PILHA(Nome, Tipo, sufixo)                                       \
+    DEFINIR_VETOR(Nome, Tipo, sufixo)                                           \
+                                                                                \
+    static inline int empilhar_##sufixo(Nome* pilha, Tipo item) {               \
+        return pilha ? anexar_##sufixo(pilha, item) : 0;                        \
+    }                                                                           \
+                                                                                \
+    static inline int desempilhar_##sufixo(Nome* pilha, Tipo* saida) {          \
+        return pilha ? remover_ultimo_##sufixo(pilha, saida) : 0;               \
+    }                                                                           \
+                                                                                \
+    static inline Tipo* topo_##sufixo(Nome* pilha) {                            \
+        return pilha ? elemento_##sufixo(pilha, pilha->tamanho - 1) : NULL;     \
+    }
+
+// Fila (FIFO) em buffer circular que cresce: elemento 0  a frente
+#define DEFINIR_FILA(Nome, Tipo, sufixo)                                        \
+    typedef struct Nome {                                                       \
+        Tipo* itens;                                                            \
+        int inicio;                                                             \
+        int tamanho;                                                            \
+        int capacidade;                                                         \
+    } Nome;                                                                     \
+                                                                                \
+    static inline void iniciar_##sufixo(Nome* fila) {                           \
+        fila->itens = NULL;                                                     \
+        fila->inicio = 0;                                                       \
+        fila->tamanho = 0;                                                      \
+        fila->capacidade = 0;                                                   \
+    }                                                                           \
+                                                                                \
+    static inline void liberar_##sufixo(Nome* fila) {                           \
+        free(fila->itens);                                                      \
+        iniciar_##sufixo(fila);                                                 \
+    }                                                                           \
+                                                                                \
+    static inline Nome* criar_##sufixo() {                                      \
+        Nome* fila = (Nome*)malloc(sizeof(Nome));                               \
+        if (fila) iniciar_##sufixo(fila);                                       \
+        return fila;                                                            \
+    }                                                                           \
+                                                                                \
+    static inline void destruir_##sufixo(Nome* fila) {                          \
+        if (!fila) return;                                                      \
+        free(fila->itens);                                                      \
+        free(fila);                                                             \
+    }                                                                           \
+                                                                                \
+    /* Realoca desfazendo a volta do buffer (frente passa ao ndice 0) */       \
+    static inline int reservar_##sufixo(Nome* fila, int capacidade) {           \
+        if (capacidade <= fila->capacidade) return 1;                           \
+        Tipo* novos = (Tipo*)malloc(capacidade * sizeof(Tipo));                \
+        if (!novos) return 0;                                                   \
+        int ate_o_fim = fila->capacidade - fila->inicio;                        \
+        if (ate_o_fim > fila->tamanho) ate_o_fim = fila->tamanho;               \
+        if (fila->tamanho > 0) {                                                \
+            memcpy(novos, fila->itens + fila->inicio, ate_o_fim * sizeof(Tipo)); \
+            memcpy(novos + ate_o_fim, fila->itens,                              \
+                   (fila->tamanho - ate_o_fim) * sizeof(Tipo));                 \
+        }                                                                       \
+        free(fila->itens);                                                      \
+        fila->itens = novos;                                                    \
+        fila->inicio = 0;                                                       \
+        fila->capacidade = capacidade;                                          \
+        return 1;                                                               \
+    }                                                                           \
+                                                                                \
+    static inline int enfileirar_##sufixo(Nome* fila, Tipo item) {              \
+        if (!fila) return 0;                                                    \
+        if (fila->tamanho == fila->capacidade) {                                \
+            int capacidade = proxima_capacidade_colecao(fila->capacidade);      \
+            if (!capacidade || !reservar_##sufixo(fila, capacidade)) return 0;  \
+        }                                                                       \
+        int posicao = fila->inicio + fila->tamanho;                             \
+        if (posicao >= fila->capacidade) posicao -= fila->capacidade;           \
+        fila->itens[posicao] = item;                                            \
+        fila->tamanho++;                                                        \
+        return 1;                                                               \
+    }                                                                           \
+                                                                                \
+    static inline int desenfileirar_##sufixo(Nome* fila, Tipo* saida) {         \
+        if (!fila || fila->tamanho == 0) return 0;                              \
+        if (saida) *saida = fila->itens[fila->inicio];                          \
+        fila->inicio = fila->inicio + 1 == fila->capacidade ? 0 : fila->inicio + 1; \
+        fila->tamanho--;                                                        \
+        return 1;                                                               \
+    }                                                                           \
+                                                                                \
+    static inline Tipo* elemento_##sufixo(Nome* fila, int indice) {             \
+        if (!fila || indice < 0 || indice >= fila->tamanho) return NULL;        \
+        int posicao = fila->inicio + indice;                                    \
+        if (posicao >= fila->capacidade) posicao -= fila->capacidade;           \
+        return &fila->itens[posicao];                                           \
+    }                                                                           \
+                                                                                \
+    static inline Tipo* frente_##sufixo(Nome* fila) {                           \
+        return elemento_##sufixo(fila, 0);                                      \
+    }                                                                           \
+                                                                                \
+    static inline int tamanho_##sufixo(const Nome* fila) {                      \
+        return fila ? fila->tamanho : 0;                                        \
+    }                                                                           \
+                                                                                \
+    static inline bool vazia_##sufixo(const Nome* fila) {                       \
+        return !fila || fila->tamanho == 0;                                     \
+    }                                                                           \
+                                                                                \
+    static inline void limpar_##sufixo(Nome* fila) {                            \
+        fila->inicio = 0;                                                       \
+        fila->tamanho = 0;                                                      \
+    }
+
+#endif
@@ -0,0 +1,638 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <time.h>
+#include "compactacao_votos.h"
+#include "pilhas.h"
+#include "arvore_resultados.h"
+#include "crc32c.h"
+
+// Segmento: num_votos (u32), bytes do contedo (u32), CRC32C do contedo (u32)
+// Contedo: cinco colunas, cada uma precedida do seu tamanho em varint:
+//   candidato  - dicionrio de valores distintos + ndices com bits empacotados
+//   CAP, urna  - run-length (valor, comprimento)
+//   eleitor    - primeiro valor + diferenas (zigzag varint)
+//   timestamp  - primeiro valor + diferenas (zigzag varint)
+
+#define TAMANHO_CABECALHO_COMPACTADO 8
+#define TAMANHO_CABECALHO_SEGMENTO 12
+#define MAXIMO_BYTES_SEGMENTO (64u << 20)  // Limite aceito na leitura
+
+// ================= BUFFER DE BYTES E VARINTS =================
+
+typedef struct BufferBytes {
+    unsigned char* dados;
+    size_t tamanho;
+    size_t capacidade;
+} BufferBytes;
+
+static int reservar_buffer(BufferBytes* buffer, size_t adicionais) {
+    if (buffer->tamanho + adicionais <= buffer->capacidade) return 1;
+    
+    size_t nova_capacidade = buffer->capacidade ? buffer->capacidade : 4096;
+    while (nova_capacidade < buffer->tamanho + adicionais) nova_capacidade *= 2;
+    
+    unsigned char* novos = (unsigned char*)realloc(buffer->dados, nova_capacidade);
+    if (!novos) return 0;
+    buffer->dados = novos;
+    buffer->capacidade = nova_capacidade;
+    return 1;
+}
+
+static int anexar_bytes(BufferBytes* buffer, const void* dados, size_t tamanho) {
+    if (!reservar_buffer(buffer, tamanho)) return 0;
+    memcpy(buffer->dados + buffer->tamanho, dados, tamanho);
+    buffer->tamanho += tamanho;
+    return 1;
+}
+
+static int anexar_varint(BufferBytes* buffer, unsigned long long valor) {
+    if (!reservar_buffer(buffer, 10)) return 0;
+    
+    while (valor >= 0x80) {
+        buffer->dados[buffer->tamanho++] = (unsigned char)(valor | 0x80);
+        valor >>= 7;
+    }
+    buffer->dados[buffer->tamanho++] = (unsigned char)valor;
+    return 1;
+}
+
+// Zigzag: inteiros pequenos (positivos ou negativos) viram varints curtos
+static unsigned long long zigzag(long long valor) {
+    return ((unsigned long long)valor << 1) ^ (unsigned long long)(valor >> 63);
+}
+
+static long long desfazer_zigzag(unsigned long long valor) {
+    return (long long)(valor >> 1) ^ -(long long)(valor & 1);
+}
+
+static void escrever_u32_le(unsigned char* p, unsigned int valor) {
+    for (int i = 0; i < 4; i++) p[i] = (valor >> (8 * i)) & 0xFF;
+}
+
+static unsigned int ler_u32_le(const unsigned char* p) {
+    return p[0] | (unsigned int)p[1] << 8 | (unsigned int)p[2] << 16 | (unsigned int)p[3] << 24;
+}
+
+// Leitor com verificao de limites (qualquer excesso marca erro)
+typedef struct LeitorBytes {
+    const unsigned char* p;
+    const unsigned char* fim;
+    int erro;
+} LeitorBytes;
+
+static unsigned long long ler_varint(LeitorBytes* leitor) {
+    unsigned long long valor = 0;
+    for (int deslocamento = 0; deslocamento < 64; deslocamento += 7) {
+        if (leitor->p >= leitor->fim) break;
+        unsigned char byte = *leitor->p++;
+        valor |= (unsigned long long)(byte & 0x7F) << deslocamento;
+        if (!(byte & 0x80)) return valor;
+    }
+    leitor->erro = 1;
+    return 0;
+}
+
+// Separa a prxima coluna (tamanho em varint + contedo)
+static LeitorBytes ler_coluna(LeitorBytes* leitor) {
+    LeitorBytes coluna = { leitor->p, leitor->p, 1 };
+    unsigned long long tamanho = ler_varint(leitor);
+    
+    if (!leitor->erro && tamanho <= (unsigned long long)(leitor->fim - leitor->p)) {
+        coluna.p = leitor->p;
+        coluna.fim = leitor->p + tamanho;
+        coluna.erro = 0;
+        leitor->p += tamanho;
+    } else {
+        leitor->erro = 1;
+    }
+    return coluna;
+}
+
+// ================= CODIFICAO DAS COLUNAS =================
+
+static int comparar_inteiros(const void* a, const void* b) {
+    int x = *(const int*)a;
+    int y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int indice_dicionario(const int* dicionario, int tamanho, int valor) {
+    int inicio = 0, fim = tamanho - 1;
+    while (inicio < fim) {
+        int meio = (inicio + fim) / 2;
+        if (dicionario[meio] < valor) inicio = meio + 1;
+        else fim = meio;
+    }
+    return inicio;
+}
+
+static int bits_necessarios(int valores_distintos) {
+    int bits = 0;
+    while ((1 << bits) < valores_distintos) bits++;
+    return bits;
+}
+
+static int codificar_candidatos(BufferBytes* coluna, const Voto* votos, int num_votos, int* auxiliar) {
+    // Dicionrio: valores distintos em ordem crescente
+    for (int i = 0; i < num_votos; i++) auxiliar[i] = votos[i].numero_candidato;
+    qsort(auxiliar, num_votos, sizeof(int), comparar_inteiros);
+    
+    int distintos = 0;
+    for (int i = 0; i < num_votos; i++) {
+        if (distintos == 0 || auxiliar[distintos - 1] != auxiliar[i]) {
+            auxiliar[distintos++] = auxiliar[i];
+        }
+    }
+    
+    if (!anexar_varint(coluna, distintos)) return 0;
+    for (int i = 0; i < distintos; i++) {
+        if (!anexar_varint(coluna, zigzag(auxiliar[i]))) return 0;
+    }
+    
+    // ndices empacotados, bit menos significativo primeiro
+    int largura = bits_necessarios(distintos);
+    unsigned char largura_byte = (unsigned char)largura;
+    if (!anexar_bytes(coluna, &largura_byte, 1)) return 0;
+    
+    size_t bytes_indices = ((size_t)num_votos * largura + 7) / 8;
+    if (!reservar_buffer(coluna, bytes_indices)) return 0;
+    
+    unsigned char* destino = coluna->dados + coluna->tamanho;
+    memset(destino, 0, bytes_indices);
+    unsigned long long acumulador = 0;
+    int bits_acumulados = 0;
+    size_t escritos = 0;
+    
+    for (int i = 0; largura > 0 && i < num_votos; i++) {
+        acumulador |= (unsigned long long)indice_dicionario(auxiliar, distintos, votos[i].numero_candidato) << bits_acumulados;
+        bits_acumulados += largura;
+        while (bits_acumulados >= 8) {
+            destino[escritos++] = (unsigned char)acumulador;
+            acumulador >>= 8;
+            bits_acumulados -= 8;
+        }
+    }
+    if (bits_acumulados > 0) destino[escritos++] = (unsigned char)acumulador;
+    
+    coluna->tamanho += bytes_indices;
+    return 1;
+}
+
+// Colunas quase constantes dentro da urna (CAP e nmero da urna)
+static int codificar_rle(BufferBytes* coluna, const Voto* votos, int num_votos, size_t deslocamento_campo) {
+    BufferBytes corridas = { NULL, 0, 0 };
+    int num_corridas = 0;
+    int sucesso = 1;
+    
+    for (int i = 0; i < num_votos && sucesso; ) {
+        int valor = *(const int*)((const char*)&votos[i] + deslocamento_campo);
+        int j = i + 1;
+        while (j < num_votos && *(const int*)((const char*)&votos[j] + deslocamento_campo) == valor) j++;
+        
+        sucesso = anexar_varint(&corridas, zigzag(valor)) && anexar_varint(&corridas, j - i);
+        num_corridas++;
+        i = j;
+    }
+    
+    sucesso = sucesso && anexar_varint(coluna, num_corridas) &&
+              anexar_bytes(coluna, corridas.dados, corridas.tamanho);
+    free(corridas.dados);
+    return sucesso;
+}
+
+static int codificar_eleitores(BufferBytes* coluna, const Voto* votos, int num_votos) {
+    long long anterior = 0;
+    for (int i = 0; i < num_votos; i++) {
+        if (!anexar_varint(coluna, zigzag((long long)votos[i].id_eleitor - anterior))) return 0;
+        anterior = votos[i].id_eleitor;
+    }
+    return 1;
+}
+
+static int codificar_timestamps(BufferBytes* coluna, const Voto* votos, int num_votos) {
+    long long anterior = 0;
+    for (int i = 0; i < num_votos; i++) {
+        if (!anexar_varint(coluna, zigzag((long long)votos[i].timestamp - anterior))) return 0;
+        anterior = (long long)votos[i].timestamp;
+    }
+    return 1;
+}
+
+// Anexa a coluna ao segmento, precedida do seu tamanho
+static int fechar_coluna(BufferBytes* segmento, BufferBytes* coluna) {
+    int sucesso = anexar_varint(segmento, coluna->tamanho) &&
+                  anexar_bytes(segmento, coluna->dados, coluna->tamanho);
+    coluna->tamanho = 0;
+    return sucesso;
+}
+
+// ================= IMPLEMENTAO ESCRITA =================
+
+EscritorCompactado* abrir_arquivo_compactado(const char* filename) {
+    if (!filename) return NULL;
+    
+    EscritorCompactado* escritor = (EscritorCompactado*)malloc(sizeof(EscritorCompactado));
+    if (!escritor) return NULL;
+    
+    escritor->arquivo = fopen(filename, "wb");
+    if (!escritor->arquivo) {
+        free(escritor);
+        return NULL;
+    }
+    
+    unsigned char cabecalho[TAMANHO_CABECALHO_COMPACTADO] = { 0 };
+    memcpy(cabecalho, MAGICA_ARQUIVO_COMPACTADO, 4);
+    cabecalho[4] = VERSAO_ARQUIVO_COMPACTADO & 0xFF;
+    cabecalho[5] = (VERSAO_ARQUIVO_COMPACTADO >> 8) & 0xFF;
+    
+    if (fwrite(cabecalho, 1, sizeof(cabecalho), escritor->arquivo) != sizeof(cabecalho)) {
+        fclose(escritor->arquivo);
+        free(escritor);
+        return NULL;
+    }
+    
+    escritor->votos_gravados = 0;
+    escritor->bytes_gravados = sizeof(cabecalho);
+    escritor->segmentos = 0;
+    return escritor;
+}
+
+static int gravar_segmento(EscritorCompactado* escritor, const Voto* votos, int num_votos,
+                           BufferBytes* segmento, BufferBytes* coluna, int* auxiliar) {
+    segmento->tamanho = 0;
+    coluna->tamanho = 0;
+    
+    int sucesso = codificar_candidatos(coluna, votos, num_votos, auxiliar) && fechar_coluna(segmento, coluna) &&
+                  codificar_rle(coluna, votos, num_votos, offsetof(Voto, id_cap)) && fechar_coluna(segmento, coluna) &&
+                  codificar_rle(coluna, votos, num_votos, offsetof(Voto, numero_urna)) && fechar_coluna(segmento, coluna) &&
+                  codificar_eleitores(coluna, votos, num_votos) && fechar_coluna(segmento, coluna) &&
+                  codificar_timestamps(coluna, votos, num_votos) && fechar_coluna(segmento, coluna);
+    if (!sucesso) return 0;
+    
+    unsigned char cabecalho[TAMANHO_CABECALHO_SEGMENTO];
+    escrever_u32_le(cabecalho, (unsigned int)num_votos);
+    escrever_u32_le(cabecalho + 4, (unsigned int)segmento->tamanho);
+    escrever_u32_le(cabecalho + 8, crc32c(0, segmento->dados, segmento->tamanho));
+    
+    if (fwrite(cabecalho, 1, sizeof(cabecalho), escritor->arquivo) != sizeof(cabecalho) ||
+        fwrite(segmento->dados, 1, segmento->tamanho, escritor->arquivo) != segmento->tamanho) {
+        return 0;
+    }
+    
+    escritor->votos_gravados += num_votos;
+    escritor->bytes_gravados += sizeof(cabecalho) + segmento->tamanho;
+    escritor->segmentos++;
+    return 1;
+}
+
+int compactar_pilha_votos(EscritorCompactado* escritor, PilhaVotos* pilha) {
+    if (!escritor || !pilha) return 0;
+    
+    int num_votos = tamanho_pilha_votos(pilha);
+    if (num_votos == 0) return 1;
+    
+    int por_segmento = num_votos < VOTOS_POR_SEGMENTO ? num_votos : VOTOS_POR_SEGMENTO;
+    Voto* votos = (Voto*)malloc(por_segmento * sizeof(Voto));
+    int* auxiliar = (int*)malloc(por_segmento * sizeof(int));
+    BufferBytes segmento = { NULL, 0, 0 };
+    BufferBytes coluna = { NULL, 0, 0 };
+    int sucesso = votos && auxiliar;
+    
+    // Segmentos em ordem de votao (do mais antigo ao mais recente)
+    for (int inicio = 0; sucesso && inicio < num_votos; inicio += por_segmento) {
+        int quantidade = num_votos - inicio < por_segmento ? num_votos - inicio : por_segmento;
+        for (int i = 0; i < quantidade; i++) {
+            votos[i] = *voto_na_posicao(pilha, inicio + i);
+        }
+        sucesso = gravar_segmento(escritor, votos, quantidade, &segmento, &coluna, auxiliar);
+    }
+    
+    free(votos);
+    free(auxiliar);
+    free(segmento.dados);
+    free(coluna.dados);
+    return sucesso;
+}
+
+int fechar_arquivo_compactado(EscritorCompactado* escritor) {
+    if (!escritor) return 0;
+    
+    int sucesso = fclose(escritor->arquivo) == 0;
+    if (sucesso && escritor->votos_gravados > 0) {
+        printf("Arquivo compactado: %lld votos em %lld bytes (%.2f bytes/voto, %d segmentos)\n",
+               escritor->votos_gravados, escritor->bytes_gravados,
+               (double)escritor->bytes_gravados / escritor->votos_gravados, escritor->segmentos);
+    }
+    free(escritor);
+    return sucesso;
+}
+
+// ================= IMPLEMENTAO LEITURA =================
+
+// Percorre os segmentos do arquivo; processar recebe o contedo j conferido
+static int percorrer_segmentos(const char* filename,
+                               int (*processar)(LeitorBytes*, int, void*), void* contexto) {
+    if (!filename) return -1;
+    
+    FILE* arquivo = fopen(filename, "rb");
+    if (!arquivo) return -1;
+    
+    unsigned char cabecalho[TAMANHO_CABECALHO_SEGMENTO];
+    int total = 0;
+    
+    if (fread(cabecalho, 1, TAMANHO_CABECALHO_COMPACTADO, arquivo) != TAMANHO_CABECALHO_COMPACTADO ||
+        memcmp(cabecalho, MAGICA_ARQUIVO_COMPACTADO, 4) != 0 ||
+        (cabecalho[4] | cabecalho[5] << 8) != VERSAO_ARQUIVO_COMPACTADO) {
+        fclose(arquivo);
+        return -1;
+    }
+    
+    BufferBytes segmento = { NULL, 0, 0 };
+    size_t lidos;
+    while ((lidos = fread(cabecalho, 1, TAMANHO_CABECALHO_SEGMENTO, arquivo)) == TAMANHO_CABECALHO_SEGMENTO) {
+        unsigned int num_votos = ler_u32_le(cabecalho);
+        unsigned int tamanho = ler_u32_le(cabecalho + 4);
+        
+        if (num_votos == 0 || num_votos > VOTOS_POR_SEGMENTO || tamanho > MAXIMO_BYTES_SEGMENTO ||
+            !reservar_buffer(&segmento, tamanho) ||
+            fread(segmento.dados, 1, tamanho, arquivo) != tamanho ||
+            crc32c(0, segmento.dados, tamanho) != ler_u32_le(cabecalho + 8)) {
+            total = -1;
+            break;
+        }
+        
+        LeitorBytes leitor = { segmento.dados, segmento.dados + tamanho, 0 };
+        if (!processar(&leitor, (int)num_votos, contexto) || leitor.erro) {
+            total = -1;
+            break;
+        }
+        total += num_votos;
+    }
+    
+    // Sobra parcial no fim = arquivo truncado
+    if (total >= 0 && lidos != 0) total = -1;
+    
+    free(segmento.dados);
+    fclose(arquivo);
+    return total;
+}
+
+// L dicionrio e largura da coluna de candidatos
+static int ler_dicionario(LeitorBytes* coluna, int** dicionario, int* largura) {
+    unsigned long long distintos = ler_varint(coluna);
+    if (coluna->erro || distintos == 0 || distintos > VOTOS_POR_SEGMENTO) return -1;
+    
+    *dicionario = (int*)malloc(distintos * sizeof(int));
+    if (!*dicionario) return -1;
+    for (unsigned long long i = 0; i < distintos; i++) {
+        (*dicionario)[i] = (int)desfazer_zigzag(ler_varint(coluna));
+    }
+    
+    if (coluna->p >= coluna->fim) coluna->erro = 1;
+    *largura = coluna->erro ? 0 : *coluna->p++;
+    if (coluna->erro || *largura != bits_necessarios((int)distintos)) {
+        free(*dicionario);
+        *dicionario = NULL;
+        return -1;
+    }
+    return (int)distintos;
+}
+
+// Entrega cada ndice empacotado da coluna de candidatos
+#define PERCORRER_INDICES(coluna, largura, num_votos, indice, corpo)            \
+    do {                                                                         \
+        unsigned long long acumulador_ = 0;                                      \
+        int bits_ = 0;                                                           \
+        unsigned int mascara_ = (1u << (largura)) - 1;                           \
+        for (int i_ = 0; i_ < (num_votos); i_++) {                               \
+            while (bits_ < (largura)) {                                          \
+                acumulador_ |= (unsigned long long)*(coluna)->p++ << bits_;      \
+                bits_ += 8;                                                      \
+            }                                                                    \
+            unsigned int indice = (unsigned int)acumulador_ & mascara_;          \
+            acumulador_ >>= (largura);                                           \
+            bits_ -= (largura);                                                  \
+            corpo                                                                \
+        }                                                                        \
+    } while (0)
+
+static int indices_cabem(LeitorBytes* coluna, int largura, int num_votos) {
+    size_t bytes = ((size_t)num_votos * largura + 7) / 8;
+    if ((size_t)(coluna->fim - coluna->p) != bytes) {
+        coluna->erro = 1;
+        return 0;
+    }
+    return 1;
+}
+
+// Expande uma coluna RLE para o campo indicado de cada voto
+static int decodificar_rle(LeitorBytes* coluna, Voto* votos, int num_votos, size_t deslocamento_campo) {
+    unsigned long long corridas = ler_varint(coluna);
+    int posicao = 0;
+    
+    for (unsigned long long c = 0; c < corridas && !coluna->erro; c++) {
+        int valor = (int)desfazer_zigzag(ler_varint(coluna));
+        unsigned long long comprimento = ler_varint(coluna);
+        if (comprimento > (unsigned long long)(num_votos - posicao)) {
+            coluna->erro = 1;
+            break;
+        }
+        for (unsigned long long k = 0; k < comprimento; k++) {
+            *(int*)((char*)&votos[posicao++] + deslocamento_campo) = valor;
+        }
+    }
+    return !coluna->erro && posicao == num_votos;
+}
+
+typedef struct ContextoPercurso {
+    void (*callback)(Voto*, void*);
+    void* contexto;
+    Voto* votos;                // Votos do segmento atual
+} ContextoPercurso;
+
+static int decodificar_segmento(LeitorBytes* leitor, int num_votos, void* contexto) {
+    ContextoPercurso* percurso = (ContextoPercurso*)contexto;
+    Voto* votos = percurso->votos;
+    
+    LeitorBytes candidatos = ler_coluna(leitor);
+    LeitorBytes caps = ler_coluna(leitor);
+    LeitorBytes urnas = ler_coluna(leitor);
+    LeitorBytes eleitores = ler_coluna(leitor);
+    LeitorBytes timestamps = ler_coluna(leitor);
+    if (leitor->erro || leitor->p != leitor->fim) return 0;
+    
+    int* dicionario;
+    int largura;
+    int distintos = ler_dicionario(&candidatos, &dicionario, &largura);
+    if (distintos < 0) return 0;
+    
+    int sucesso = 1;
+    if (largura == 0) {
+        for (int i = 0; i < num_votos; i++) votos[i].numero_candidato = dicionario[0];
+    } else if (indices_cabem(&candidatos, largura, num_votos)) {
+        int v = 0;
+        PERCORRER_INDICES(&candidatos, largura, num_votos, indice, {
+            if ((int)indice >= distintos) sucesso = 0;
+            else votos[v].numero_candidato = dicionario[indice];
+            v++;
+        });
+    } else {
+        sucesso = 0;
+    }
+    free(dicionario);
+    
+    sucesso = sucesso && decodificar_rle(&caps, votos, num_votos, offsetof(Voto, id_cap)) &&
+              decodificar_rle(&urnas, votos, num_votos, offsetof(Voto, numero_urna));
+    
+    long long eleitor = 0, instante = 0;
+    for (int i = 0; sucesso && i < num_votos; i++) {
+        eleitor += desfazer_zigzag(ler_varint(&eleitores));
+        instante += desfazer_zigzag(ler_varint(&timestamps));
+        votos[i].id_eleitor = (int)eleitor;
+        votos[i].timestamp = (time_t)instante;
+    }
+    if (!sucesso || eleitores.erro || timestamps.erro ||
+        eleitores.p != eleitores.fim || timestamps.p != timestamps.fim) return 0;
+    
+    for (int i = 0; i < num_votos; i++) {
+        percurso->callback(&votos[i], percurso->contexto);
+    }
+    return 1;
+}
+
+int percorrer_arquivo_compactado(const char* filename, void (*callback)(Voto*, void*), void* contexto) {
+    if (!callback) return -1;
+    
+    ContextoPercurso percurso = { callback, contexto, (Voto*)malloc(VOTOS_POR_SEGMENTO * sizeof(Voto)) };
+    if (!percurso.votos) return -1;
+    
+    int total = percorrer_segmentos(filename, decodificar_segmento, &percurso);
+    free(percurso.votos);
+    return total;
+}
+
+typedef struct ContextoContagem {
+    void (*callback)(int, int, void*);
+    void* contexto;
+    int* contagens;             // Votos por entrada do dicionrio
+} ContextoContagem;
+
+// S a coluna de candidatos  decodificada; as demais so puladas
+static int contar_segmento(LeitorBytes* leitor, int num_votos, void* contexto) {
+    ContextoContagem* contagem = (ContextoContagem*)contexto;
+    
+    LeitorBytes candidatos = ler_coluna(leitor);
+    if (leitor->erro) return 0;
+    
+    int* dicionario;
+    int largura;
+    int distintos = ler_dicionario(&candidatos, &dicionario, &largura);
+    if (distintos < 0) return 0;
+    
+    int* contagens = contagem->contagens;
+    memset(contagens, 0, distintos * sizeof(int));
+    
+    int sucesso = 1;
+    if (largura == 0) {
+        contagens[0] = num_votos;
+    } else if (indices_cabem(&candidatos, largura, num_votos)) {
+        PERCORRER_INDICES(&candidatos, largura, num_votos, indice, {
+            if ((int)indice < distintos) contagens[indice]++;
+            else sucesso = 0;
+        });
+    } else {
+        sucesso = 0;
+    }
+    
+    for (int i = 0; sucesso && i < distintos; i++) {
+        if (contagens[i] > 0) contagem->callback(dicionario[i], contagens[i], contagem->contexto);
+    }
+    free(dicionario);
+    return sucesso;
+}
+
+int contar_votos_arquivo_compactado(const char* filename,
+                                    void (*callback)(int numero_candidato, int votos, void*),
+                                    void* contexto) {
+    if (!callback) return -1;
+    
+    ContextoContagem contagem = { callback, contexto, (int*)malloc(VOTOS_POR_SEGMENTO * sizeof(int)) };
+    if (!contagem.contagens) return -1;
+    
+    int total = percorrer_segmentos(filename, contar_segmento, &contagem);
+    free(contagem.contagens);
+    return total;
+}
+
+// Votos do arquivo acumulados fora da rvore: s entram nela depois que o
+// arquivo inteiro foi lido sem erro
+typedef struct ContextoApuracaoCompactada {
+    int* numeros;               // IDs da rvore, em ordem crescente
+    int* votos;                 // Votos lidos para cada ID
+    int quantidade;
+    int desconhecidos;          // Votos para nmeros fora da rvore
+} ContextoApuracaoCompactada;
+
+static void somar_votos_candidato(int numero_candidato, int votos, void* contexto) {
+    ContextoApuracaoCompactada* apuracao = (ContextoApuracaoCompactada*)contexto;
+    
+    int inicio = 0, fim = apuracao->quantidade;
+    while (inicio < fim) {
+        int meio = inicio + (fim - inicio) / 2;
+        if (apuracao->numeros[meio] < numero_candidato) inicio = meio + 1;
+        else fim = meio;
+    }
+    
+    if (inicio < apuracao->quantidade && apuracao->numeros[inicio] == numero_candidato) {
+        apuracao->votos[inicio] += votos;
+    } else {
+        apuracao->desconhecidos += votos;
+    }
+}
+
+int apurar_arquivo_compactado(const char* filename, ArvoreResultados* arvore_candidatos) {
+    if (!arvore_candidatos) return -1;
+    
+    // O percurso em ordem j entrega os IDs ordenados para a busca binria
+    int quantidade = total_nos_arvore(arvore_candidatos);
+    ContextoApuracaoCompactada apuracao = { NULL, NULL, 0, 0 };
+    apuracao.numeros = (int*)malloc((quantidade + 1) * sizeof(int));
+    apuracao.votos = (int*)calloc(quantidade + 1, sizeof(int));
+    if (!apuracao.numeros || !apuracao.votos) {
+        free(apuracao.numeros);
+        free(apuracao.votos);
+        return -1;
+    }
+    
+    IteradorArvore it;
+    iniciar_iterador_arvore(&it, arvore_candidatos->raiz, PERCURSO_EM_ORDEM);
+    ResultadoVotacao* resultado;
+    while ((resultado = proximo_resultado_iterador(&it)) != NULL && apuracao.quantidade < quantidade) {
+        apuracao.numeros[apuracao.quantidade++] = resultado->id;
+    }
+    
+    int total = contar_votos_arquivo_compactado(filename, somar_votos_candidato, &apuracao);
+    if (total < 0) {
+        // Nenhum segmento chegou  rvore: a apurao fica como estava
+        printf("Arquivo compactado %s invalido ou corrompido!\n", filename);
+        free(apuracao.numeros);
+        free(apuracao.votos);
+        return -1;
+    }
+    
+    for (int i = 0; i < apuracao.quantidade; i++) {
+        if (apuracao.votos[i] != 0) {
+            atualizar_votos_resultado(arvore_candidatos, apuracao.numeros[i], apuracao.votos[i]);
+        }
+    }
+    free(apuracao.numeros);
+    free(apuracao.votos);
+    
+    atualizar_percentuais_arvore(arvore_candidatos);
+    if (apuracao.desconhecidos > 0) {
+        printf("Aviso: %d votos para candidatos nao cadastrados foram ignorados.\n", apuracao.desconhecidos);
+    }
+    return total;
+}
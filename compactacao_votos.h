@@ -0,0 +1,33 @@
+#ifndef COMPACTACAO_VOTOS_H
+#define COMPACTACAO_VOTOS_H
+
+#include <stdio.h>
+#include "estruturas.h"
+
+// ================= ARQUIVO COLUNAR COMPACTADO DE VOTOS =================
+
+#define MAGICA_ARQUIVO_COMPACTADO "SGVC"
+#define VERSAO_ARQUIVO_COMPACTADO 1
+#define VOTOS_POR_SEGMENTO 65536      // Mximo de votos por segmento
+
+// Escrita sequencial: cada urna vira um ou mais segmentos independentes
+typedef struct EscritorCompactado {
+    FILE* arquivo;
+    long long votos_gravados;
+    long long bytes_gravados;   // Inclui cabealhos
+    int segmentos;
+} EscritorCompactado;
+
+// Escrita
+EscritorCompactado* abrir_arquivo_compactado(const char* filename);
+int compactar_pilha_votos(EscritorCompactado* escritor, PilhaVotos* pilha);
+int fechar_arquivo_compactado(EscritorCompactado* escritor);
+
+// Leitura em fluxo (segmento a segmento, com verificao de CRC32C)
+int percorrer_arquivo_compactado(const char* filename, void (*callback)(Voto*, void*), void* contexto);
+int contar_votos_arquivo_compactado(const char* filename,
+                                    void (*callback)(int numero_candidato, int votos, void*),
+                                    void* contexto);
+int apurar_arquivo_compactado(const char* filename, ArvoreResultados* arvore_candidatos);
+
+#endif
@@ -0,0 +1,109 @@
+#include <stdint.h>
+#include <pthread.h>
+#include "crc32c.h"
+
+#define POLINOMIO_CRC32C 0x82F63B78u  // Castagnoli, refletido
+
+// ================= IMPLEMENTAO POR TABELA (SLICING-BY-8) =================
+
+static uint32_t tabela_crc32c[8][256];
+
+static uint32_t crc32c_tabela(uint32_t crc, const unsigned char* p, size_t tamanho) {
+    // Byte a byte at alinhar em 8
+    while (tamanho > 0 && ((uintptr_t)p & 7) != 0) {
+        crc = tabela_crc32c[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        tamanho--;
+    }
+    
+    // Oito bytes por iterao (montados em little-endian, independente do host)
+    while (tamanho >= 8) {
+        uint32_t baixo = crc ^ ((uint32_t)p[0] | (uint32_t)p[1] << 8 |
+                                (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+        uint32_t alto = (uint32_t)p[4] | (uint32_t)p[5] << 8 |
+                        (uint32_t)p[6] << 16 | (uint32_t)p[7] << 24;
+        crc = tabela_crc32c[7][baixo & 0xFF] ^ tabela_crc32c[6][(baixo >> 8) & 0xFF] ^
+              tabela_crc32c[5][(baixo >> 16) & 0xFF] ^ tabela_crc32c[4][baixo >> 24] ^
+              tabela_crc32c[3][alto & 0xFF] ^ tabela_crc32c[2][(alto >> 8) & 0xFF] ^
+              tabela_crc32c[1][(alto >> 16) & 0xFF] ^ tabela_crc32c[0][alto >> 24];
+        p += 8;
+        tamanho -= 8;
+    }
+    
+    while (tamanho > 0) {
+        crc = tabela_crc32c[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+        tamanho--;
+    }
+    return crc;
+}
+
+// ================= IMPLEMENTAO POR HARDWARE (SSE4.2) =================
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define CRC32C_X86 1
+
+__attribute__((target("sse4.2")))
+static uint32_t crc32c_hardware(uint32_t crc, const unsigned char* p, size_t tamanho) {
+    while (tamanho > 0 && ((uintptr_t)p & 7) != 0) {
+        crc = __builtin_ia32_crc32qi(crc, *p++);
+        tamanho--;
+    }
+    
+    uint64_t crc64 = crc;
+    while (tamanho >= 8) {
+        uint64_t palavra;
+        __builtin_memcpy(&palavra, p, 8);
+        crc64 = __builtin_ia32_crc32di(crc64, palavra);
+        p += 8;
+        tamanho -= 8;
+    }
+    crc = (uint32_t)crc64;
+    
+    while (tamanho > 0) {
+        crc = __builtin_ia32_crc32qi(crc, *p++);
+        tamanho--;
+    }
+    return crc;
+}
+#endif
+
+// ================= SELEO EM TEMPO DE EXECUO =================
+
+static uint32_t (*implementacao_crc32c)(uint32_t, const unsigned char*, size_t) = crc32c_tabela;
+static pthread_once_t inicializacao_crc32c = PTHREAD_ONCE_INIT;
+
+static void inicializar_crc32c() {
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ POLINOMIO_CRC32C : crc >> 1;
+        }
+        tabela_crc32c[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (int k = 1; k < 8; k++) {
+            uint32_t anterior = tabela_crc32c[k - 1][i];
+            tabela_crc32c[k][i] = tabela_crc32c[0][anterior & 0xFF] ^ (anterior >> 8);
+        }
+    }
+    
+#ifdef CRC32C_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("sse4.2")) {
+        implementacao_crc32c = crc32c_hardware;
+    }
+#endif
+}
+
+unsigned int crc32c(unsigned int crc, const void* dados, size_t tamanho) {
+    pthread_once(&inicializacao_crc32c, inicializar_crc32c);
+    return ~implementacao_crc32c(~(uint32_t)crc, (const unsigned char*)dados, tamanho);
+}
+
+bool crc32c_acelerado() {
+    pthread_once(&inicializacao_crc32c, inicializar_crc32c);
+#ifdef CRC32C_X86
+    return implementacao_crc32c == crc32c_hardware;
+#else
+    return false;
+#endif
+}
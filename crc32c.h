@@ -0,0 +1,15 @@
+#ifndef CRC32C_H
+#define CRC32C_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+// ================= CRC32C (CASTAGNOLI) =================
+
+// Continua o clculo a partir de crc (use 0 no incio)
+unsigned int crc32c(unsigned int crc, const void* dados, size_t tamanho);
+
+// Indica se a instruo crc32 do processador est em uso
+bool crc32c_acelerado();
+
+#endif
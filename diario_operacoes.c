@@ -0,0 +1,325 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include "diario_operacoes.h"
+#include "pilhas.h"
+
+#define LOTE_LEITURA_DIARIO 256
+
+// ================= IMPLEMENTAO ESCRITA DO DIRIO =================
+
+// Escreve todos os trechos com writev, retomando aps escritas parciais
+static int escrever_trechos(int fd, struct iovec* trechos, int num_trechos) {
+    while (num_trechos > 0) {
+        ssize_t escritos = writev(fd, trechos, num_trechos);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return 0;
+        }
+        
+        while (num_trechos > 0 && (size_t)escritos >= trechos->iov_len) {
+            escritos -= trechos->iov_len;
+            trechos++;
+            num_trechos--;
+        }
+        if (escritos > 0) {
+            trechos->iov_base = (char*)trechos->iov_base + escritos;
+            trechos->iov_len -= escritos;
+        }
+    }
+    return 1;
+}
+
+// Grava registros [inicio, fim) da fila circular, no mximo dois trechos contguos
+static int gravar_lote(DiarioOperacoes* diario, unsigned long long inicio, unsigned long long fim) {
+    unsigned int mascara = CAPACIDADE_FILA_DIARIO - 1;
+    struct iovec trechos[2];
+    int num_trechos = 0;
+    
+    while (inicio < fim) {
+        unsigned int indice = (unsigned int)(inicio & mascara);
+        unsigned long long quantidade = fim - inicio;
+        if (indice + quantidade > CAPACIDADE_FILA_DIARIO) {
+            quantidade = CAPACIDADE_FILA_DIARIO - indice;
+        }
+        
+        trechos[num_trechos].iov_base = &diario->fila[indice];
+        trechos[num_trechos].iov_len = (size_t)quantidade * sizeof(Operacao);
+        num_trechos++;
+        inicio += quantidade;
+    }
+    
+    return escrever_trechos(diario->descritor, trechos, num_trechos);
+}
+
+static void* executar_escritor(void* argumento) {
+    DiarioOperacoes* diario = (DiarioOperacoes*)argumento;
+    struct timespec pausa = { 0, INTERVALO_ESCRITOR_MS * 1000000L };
+    
+    for (;;) {
+        unsigned long long cauda = __atomic_load_n(&diario->cauda, __ATOMIC_RELAXED);
+        unsigned long long cabeca = __atomic_load_n(&diario->cabeca, __ATOMIC_ACQUIRE);
+        
+        if (cabeca == cauda) {
+            // Fila vazia: terminar somente depois de tudo gravado
+            if (__atomic_load_n(&diario->encerrar, __ATOMIC_ACQUIRE) &&
+                __atomic_load_n(&diario->cabeca, __ATOMIC_ACQUIRE) == cauda) {
+                break;
+            }
+            nanosleep(&pausa, NULL);
+            continue;
+        }
+        
+        // Tudo o que chegou desde a ltima passada vai num nico lote
+        if (__atomic_load_n(&diario->falha_gravacao, __ATOMIC_RELAXED)) {
+            __atomic_add_fetch(&diario->descartadas, cabeca - cauda, __ATOMIC_RELAXED);
+        } else if (gravar_lote(diario, cauda, cabeca)) {
+            diario->gravadas += cabeca - cauda;
+            diario->tamanho_valido += (long long)(cabeca - cauda) * sizeof(Operacao);
+        } else {
+            // Um lote gravado pela metade deixaria os prximos desalinhados:
+            // volta ao ltimo registro inteiro e para de gravar
+            if (ftruncate(diario->descritor, (off_t)diario->tamanho_valido) != 0) {
+                diario->tamanho_valido = -1;
+            }
+            __atomic_add_fetch(&diario->descartadas, cabeca - cauda, __ATOMIC_RELAXED);
+            __atomic_store_n(&diario->falha_gravacao, 1, __ATOMIC_RELEASE);
+        }
+        
+        __atomic_store_n(&diario->cauda, cabeca, __ATOMIC_RELEASE);
+    }
+    
+    return NULL;
+}
+
+static int ler_cabecalho_diario(int fd, CabecalhoDiario* cabecalho) {
+    return pread(fd, cabecalho, sizeof(CabecalhoDiario), 0) == (ssize_t)sizeof(CabecalhoDiario) &&
+           memcmp(cabecalho->magica, MAGICA_DIARIO_OPERACOES, 4) == 0 &&
+           cabecalho->versao == VERSAO_DIARIO_OPERACOES &&
+           cabecalho->tamanho_registro == sizeof(Operacao);
+}
+
+DiarioOperacoes* abrir_diario_operacoes(const char* filename) {
+    if (!filename) return NULL;
+    
+    int fd = open(filename, O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) return NULL;
+    
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return NULL;
+    }
+    
+    // Arquivo novo recebe cabealho; arquivo existente precisa ser compatvel
+    CabecalhoDiario cabecalho;
+    long long tamanho_valido = sizeof(CabecalhoDiario);
+    if (info.st_size == 0) {
+        memcpy(cabecalho.magica, MAGICA_DIARIO_OPERACOES, 4);
+        cabecalho.versao = VERSAO_DIARIO_OPERACOES;
+        cabecalho.tamanho_registro = sizeof(Operacao);
+        struct iovec trecho = { &cabecalho, sizeof(CabecalhoDiario) };
+        if (!escrever_trechos(fd, &trecho, 1)) {
+            printf("Falha ao gravar o cabecalho do diario %s!\n", filename);
+            close(fd);
+            return NULL;
+        }
+    } else {
+        if (!ler_cabecalho_diario(fd, &cabecalho)) {
+            printf("Diario de operacoes %s incompativel!\n", filename);
+            close(fd);
+            return NULL;
+        }
+        
+        // Uma queda no meio de um lote deixa um registro incompleto no fim;
+        // sem cort-lo, tudo o que fosse acrescentado sairia desalinhado
+        long long registros = ((long long)info.st_size - (long long)sizeof(CabecalhoDiario)) /
+                              (long long)sizeof(Operacao);
+        tamanho_valido += registros * (long long)sizeof(Operacao);
+        if (tamanho_valido != (long long)info.st_size) {
+            if (ftruncate(fd, (off_t)tamanho_valido) != 0) {
+                printf("Diario de operacoes %s com registro incompleto e sem permissao de corte!\n",
+                       filename);
+                close(fd);
+                return NULL;
+            }
+            printf("Aviso: registro incompleto no fim do diario %s descartado\n", filename);
+        }
+    }
+    
+    DiarioOperacoes* diario = (DiarioOperacoes*)malloc(sizeof(DiarioOperacoes));
+    if (!diario) {
+        close(fd);
+        return NULL;
+    }
+    
+    diario->fila = (Operacao*)malloc(CAPACIDADE_FILA_DIARIO * sizeof(Operacao));
+    if (!diario->fila) {
+        free(diario);
+        close(fd);
+        return NULL;
+    }
+    
+    diario->descritor = fd;
+    diario->tamanho_valido = tamanho_valido;
+    diario->falha_gravacao = 0;
+    diario->cabeca = 0;
+    diario->cauda = 0;
+    diario->descartadas = 0;
+    diario->gravadas = 0;
+    diario->encerrar = 0;
+    
+    if (pthread_create(&diario->escritor, NULL, executar_escritor, diario) != 0) {
+        free(diario->fila);
+        free(diario);
+        close(fd);
+        return NULL;
+    }
+    
+    return diario;
+}
+
+void fechar_diario_operacoes(DiarioOperacoes* diario) {
+    if (!diario) return;
+    
+    // O escritor esvazia a fila antes de terminar
+    __atomic_store_n(&diario->encerrar, 1, __ATOMIC_RELEASE);
+    pthread_join(diario->escritor, NULL);
+    
+    if (diario->falha_gravacao) {
+        printf("Erro: falha de escrita no diario de operacoes; gravacao interrompida apos %llu operacoes\n",
+               diario->gravadas);
+        if (diario->tamanho_valido < 0) {
+            printf("Erro: o diario pode terminar com um registro incompleto\n");
+        }
+    }
+    if (diario->descartadas > 0) {
+        printf("Aviso: %llu operacoes nao gravadas no diario\n", diario->descartadas);
+    }
+    
+    close(diario->descritor);
+    free(diario->fila);
+    free(diario);
+}
+
+int diario_com_falha(DiarioOperacoes* diario) {
+    return diario ? __atomic_load_n(&diario->falha_gravacao, __ATOMIC_ACQUIRE) : 0;
+}
+
+int diario_registrar_operacao(DiarioOperacoes* diario, const Operacao* operacao) {
+    if (!diario || !operacao) return 0;
+    
+    // Depois de uma falha de escrita nada mais chega ao disco
+    if (__atomic_load_n(&diario->falha_gravacao, __ATOMIC_ACQUIRE)) {
+        __atomic_add_fetch(&diario->descartadas, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    
+    unsigned long long cabeca = __atomic_load_n(&diario->cabeca, __ATOMIC_RELAXED);
+    unsigned long long cauda = __atomic_load_n(&diario->cauda, __ATOMIC_ACQUIRE);
+    
+    // Fila cheia: descartar em vez de esperar pelo disco
+    if (cabeca - cauda >= CAPACIDADE_FILA_DIARIO) {
+        __atomic_add_fetch(&diario->descartadas, 1, __ATOMIC_RELAXED);
+        return 0;
+    }
+    
+    diario->fila[cabeca & (CAPACIDADE_FILA_DIARIO - 1)] = *operacao;
+    __atomic_store_n(&diario->cabeca, cabeca + 1, __ATOMIC_RELEASE);
+    return 1;
+}
+
+// ================= IMPLEMENTAO LEITURA DO DIRIO =================
+
+void inicializar_filtro_diario(FiltroDiario* filtro) {
+    if (!filtro) return;
+    
+    filtro->tipo = -1;
+    filtro->usuario_id = -1;
+    filtro->inicio = 0;
+    filtro->fim = 0;
+}
+
+int operacao_atende_filtro(const Operacao* operacao, const FiltroDiario* filtro) {
+    if (!operacao) return 0;
+    if (!filtro) return 1;
+    
+    if (filtro->tipo >= 0 && operacao->tipo != filtro->tipo) return 0;
+    if (filtro->usuario_id >= 0 && operacao->usuario_id != filtro->usuario_id) return 0;
+    if (filtro->inicio && (time_t)operacao->timestamp < filtro->inicio) return 0;
+    if (filtro->fim && (time_t)operacao->timestamp > filtro->fim) return 0;
+    
+    return 1;
+}
+
+int percorrer_diario_operacoes(const char* filename, const FiltroDiario* filtro,
+                               void (*callback)(Operacao*, void*), void* contexto) {
+    if (!filename) return -1;
+    
+    FILE* arquivo = fopen(filename, "rb");
+    if (!arquivo) return -1;
+    
+    CabecalhoDiario cabecalho;
+    if (fread(&cabecalho, sizeof(CabecalhoDiario), 1, arquivo) != 1 ||
+        memcmp(cabecalho.magica, MAGICA_DIARIO_OPERACOES, 4) != 0 ||
+        cabecalho.versao != VERSAO_DIARIO_OPERACOES ||
+        cabecalho.tamanho_registro != sizeof(Operacao)) {
+        fclose(arquivo);
+        return -1;
+    }
+    
+    Operacao* lote = (Operacao*)malloc(LOTE_LEITURA_DIARIO * sizeof(Operacao));
+    if (!lote) {
+        fclose(arquivo);
+        return -1;
+    }
+    
+    // Leitura em lotes; um registro incompleto no fim (queda)  ignorado
+    int encontradas = 0;
+    size_t lidos;
+    while ((lidos = fread(lote, sizeof(Operacao), LOTE_LEITURA_DIARIO, arquivo)) > 0) {
+        for (size_t i = 0; i < lidos; i++) {
+            if (operacao_atende_filtro(&lote[i], filtro)) {
+                if (callback) callback(&lote[i], contexto);
+                encontradas++;
+            }
+        }
+    }
+    
+    free(lote);
+    fclose(arquivo);
+    return encontradas;
+}
+
+static void reproduzir_operacao(Operacao* operacao, void* contexto) {
+    anexar_operacao_historico((HistoricoOperacoes*)contexto, operacao);
+}
+
+int reproduzir_diario_operacoes(const char* filename, const FiltroDiario* filtro,
+                                HistoricoOperacoes* destino) {
+    if (!destino) return -1;
+    return percorrer_diario_operacoes(filename, filtro, reproduzir_operacao, destino);
+}
+
+static void imprimir_operacao_diario(Operacao* operacao, void* contexto) {
+    (void)contexto;
+    imprimir_operacao(operacao);
+}
+
+void imprimir_diario_operacoes(const char* filename, const FiltroDiario* filtro) {
+    printf("=== DIARIO DE OPERACOES (%s) ===\n", filename ? filename : "?");
+    
+    int encontradas = percorrer_diario_operacoes(filename, filtro, imprimir_operacao_diario, NULL);
+    if (encontradas < 0) {
+        printf("Diario inexistente ou invalido!\n");
+    } else {
+        printf("%d operacao(oes) encontrada(s)\n", encontradas);
+    }
+}
@@ -0,0 +1,59 @@
+#ifndef DIARIO_OPERACOES_H
+#define DIARIO_OPERACOES_H
+
+#include <pthread.h>
+#include "estruturas.h"
+
+// ================= DIRIO BINRIO DE OPERAES =================
+
+#define ARQUIVO_DIARIO_OPERACOES "operacoes.diario"
+#define MAGICA_DIARIO_OPERACOES "SGOP"
+#define VERSAO_DIARIO_OPERACOES 3      // 3: CAP e urna com 32 bits (2: com 16 bits)
+#define CAPACIDADE_FILA_DIARIO 4096   // Registros pendentes (potncia de 2)
+#define INTERVALO_ESCRITOR_MS 1       // Espera do escritor quando no h registros
+
+// Cabealho gravado no incio do arquivo
+typedef struct CabecalhoDiario {
+    char magica[4];             // "SGOP"
+    unsigned int versao;        // Verso do formato
+    unsigned int tamanho_registro; // sizeof(Operacao) de quem gravou
+} CabecalhoDiario;
+
+// Dirio com fila sem bloqueio (um produtor, um consumidor) e thread escritora
+typedef struct DiarioOperacoes {
+    int descritor;              // Arquivo aberto para acrscimo (O_APPEND)
+    long long tamanho_valido;   // Bytes do arquivo s com registros inteiros
+    int falha_gravacao;         // 1 aps erro de escrita: o dirio para de gravar
+    Operacao* fila;             // Registros aguardando gravao
+    unsigned long long cabeca;  // Prxima posio a escrever (produtor)
+    unsigned long long cauda;   // Prxima posio a gravar (escritor)
+    unsigned long long descartadas; // Operaes perdidas (fila cheia ou falha de gravao)
+    unsigned long long gravadas;    // Operaes gravadas em disco
+    int encerrar;               // Sinaliza fim para a thread escritora
+    pthread_t escritor;         // Thread que grava em lotes
+} DiarioOperacoes;
+
+// Filtro para leitura do dirio
+typedef struct FiltroDiario {
+    int tipo;                   // TipoOperacao; -1 = qualquer tipo
+    int usuario_id;             // -1 = qualquer usurio
+    time_t inicio;              // 0 = sem limite inferior
+    time_t fim;                 // 0 = sem limite superior
+} FiltroDiario;
+
+// Escrita (thread de votao nunca espera por disco)
+DiarioOperacoes* abrir_diario_operacoes(const char* filename);
+void fechar_diario_operacoes(DiarioOperacoes* diario);
+int diario_registrar_operacao(DiarioOperacoes* diario, const Operacao* operacao);
+int diario_com_falha(DiarioOperacoes* diario);
+
+// Leitura, filtragem e reproduo
+void inicializar_filtro_diario(FiltroDiario* filtro);
+int operacao_atende_filtro(const Operacao* operacao, const FiltroDiario* filtro);
+int percorrer_diario_operacoes(const char* filename, const FiltroDiario* filtro,
+                               void (*callback)(Operacao*, void*), void* contexto);
+int reproduzir_diario_operacoes(const char* filename, const FiltroDiario* filtro,
+                                HistoricoOperacoes* destino);
+void imprimir_diario_operacoes(const char* filename, const FiltroDiario* filtro);
+
+#endif
@@ -0,0 +1,294 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>      // signbit
+#include <pthread.h>
+#include "escritor_saida.h"
+
+// ================= IMPLEMENTAO TABELAS DE CLASSIFICAO =================
+
+// Classe de cada byte dentro de uma string JSON
+#define JSON_LITERAL 0     // Copiado como est
+#define JSON_CURTO 1       // Barra + letra (\" \\ \n ...)
+#define JSON_CONTROLE 2    // \u00XX
+#define JSON_NAO_ASCII 3   // Incio de sequncia UTF-8 (ou Latin-1 solto)
+#define JSON_FIM 4         // Terminador da string
+
+static unsigned char classe_json[256];
+static char escape_json[256];      // Letra do escape curto
+static unsigned char exige_aspas_csv[256];
+
+static pthread_once_t inicializacao_escritor = PTHREAD_ONCE_INIT;
+
+static void inicializar_tabelas_escritor(void) {
+    for (int c = 0; c < 256; c++) {
+        classe_json[c] = (c < 0x20) ? JSON_CONTROLE : (c >= 0x80) ? JSON_NAO_ASCII : JSON_LITERAL;
+    }
+    classe_json['"'] = JSON_CURTO;  escape_json['"'] = '"';
+    classe_json['\\'] = JSON_CURTO; escape_json['\\'] = '\\';
+    classe_json['\b'] = JSON_CURTO; escape_json['\b'] = 'b';
+    classe_json['\f'] = JSON_CURTO; escape_json['\f'] = 'f';
+    classe_json['\n'] = JSON_CURTO; escape_json['\n'] = 'n';
+    classe_json['\r'] = JSON_CURTO; escape_json['\r'] = 'r';
+    classe_json['\t'] = JSON_CURTO; escape_json['\t'] = 't';
+    classe_json[0] = JSON_FIM;
+    
+    exige_aspas_csv[';'] = 1;
+    exige_aspas_csv['"'] = 1;
+    exige_aspas_csv['\n'] = 1;
+    exige_aspas_csv['\r'] = 1;
+}
+
+// ================= IMPLEMENTAO ESCRITOR =================
+
+static EscritorSaida* criar_escritor(size_t tamanho_buffer) {
+    pthread_once(&inicializacao_escritor, inicializar_tabelas_escritor);
+    
+    EscritorSaida* escritor = (EscritorSaida*)malloc(sizeof(EscritorSaida));
+    if (!escritor) return NULL;
+    
+    // Espao para o maior item montado de uma vez (nmero ou caractere escapado)
+    if (tamanho_buffer < 64) tamanho_buffer = tamanho_buffer ? 64 : TAMANHO_BUFFER_ESCRITOR;
+    escritor->buffer = (char*)malloc(tamanho_buffer);
+    if (!escritor->buffer) {
+        free(escritor);
+        return NULL;
+    }
+    escritor->capacidade = tamanho_buffer;
+    escritor->usado = 0;
+    escritor->arquivo = NULL;
+    escritor->destino = NULL;
+    escritor->contexto = NULL;
+    escritor->erro = 0;
+    return escritor;
+}
+
+EscritorSaida* criar_escritor_arquivo(const char* filename, size_t tamanho_buffer) {
+    if (!filename) return NULL;
+    
+    EscritorSaida* escritor = criar_escritor(tamanho_buffer);
+    if (!escritor) return NULL;
+    
+    escritor->arquivo = fopen(filename, "w");
+    if (!escritor->arquivo) {
+        free(escritor->buffer);
+        free(escritor);
+        return NULL;
+    }
+    // Os blocos j chegam grandes: o buffer do stdio s copiaria de novo
+    setvbuf(escritor->arquivo, NULL, _IONBF, 0);
+    return escritor;
+}
+
+EscritorSaida* criar_escritor_blocos(DestinoBlocoSaida destino, void* contexto, size_t tamanho_buffer) {
+    if (!destino) return NULL;
+    
+    EscritorSaida* escritor = criar_escritor(tamanho_buffer);
+    if (!escritor) return NULL;
+    
+    escritor->destino = destino;
+    escritor->contexto = contexto;
+    return escritor;
+}
+
+static void entregar(EscritorSaida* escritor, const char* dados, size_t tamanho) {
+    if (tamanho == 0 || escritor->erro) return;
+    
+    int ok = escritor->arquivo
+        ? fwrite(dados, 1, tamanho, escritor->arquivo) == tamanho
+        : escritor->destino(dados, tamanho, escritor->contexto);
+    if (!ok) escritor->erro = 1;
+}
+
+int descarregar_escritor(EscritorSaida* escritor) {
+    if (!escritor) return 0;
+    entregar(escritor, escritor->buffer, escritor->usado);
+    escritor->usado = 0;
+    return !escritor->erro;
+}
+
+int fechar_escritor(EscritorSaida* escritor) {
+    if (!escritor) return 0;
+    
+    descarregar_escritor(escritor);
+    if (escritor->arquivo && fclose(escritor->arquivo) != 0) escritor->erro = 1;
+    
+    int ok = !escritor->erro;
+    free(escritor->buffer);
+    free(escritor);
+    return ok;
+}
+
+// Garante espao contguo para n bytes (n <= capacidade)
+static char* reservar(EscritorSaida* escritor, size_t n) {
+    if (escritor->capacidade - escritor->usado < n) descarregar_escritor(escritor);
+    return escritor->buffer + escritor->usado;
+}
+
+void escrever_bytes(EscritorSaida* escritor, const char* dados, size_t tamanho) {
+    if (!escritor) return;
+    
+    if (escritor->capacidade - escritor->usado < tamanho) {
+        descarregar_escritor(escritor);
+        // Maior que o bloco inteiro: vai direto, sem passar pelo buffer
+        if (tamanho >= escritor->capacidade) {
+            entregar(escritor, dados, tamanho);
+            return;
+        }
+    }
+    memcpy(escritor->buffer + escritor->usado, dados, tamanho);
+    escritor->usado += tamanho;
+}
+
+void escrever_texto(EscritorSaida* escritor, const char* texto) {
+    if (texto) escrever_bytes(escritor, texto, strlen(texto));
+}
+
+// Dgitos de v (sem sinal) escritos de trs para frente a partir de fim
+static char* formatar_sem_sinal(char* fim, unsigned long long v) {
+    do {
+        *--fim = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    return fim;
+}
+
+void escrever_inteiro(EscritorSaida* escritor, int valor) {
+    if (!escritor) return;
+    
+    char digitos[16];
+    char* fim = digitos + sizeof(digitos);
+    unsigned long long modulo = valor < 0 ? 0ULL - (unsigned long long)valor : (unsigned long long)valor;
+    char* inicio = formatar_sem_sinal(fim, modulo);
+    if (valor < 0) *--inicio = '-';
+    escrever_bytes(escritor, inicio, fim - inicio);
+}
+
+void escrever_decimal(EscritorSaida* escritor, float valor) {
+    if (!escritor) return;
+    
+    // float * 100 cabe exato num double (24 + 7 bits), ento o arredondamento
+    // abaixo (metade para o par, sobre o valor exato)  o mesmo do printf
+    double escalado = (double)valor * 100.0;
+    if (escalado < 0) escalado = -escalado;
+    if (escalado != escalado || escalado >= 1e15) {
+        char texto[64];
+        int n = snprintf(texto, sizeof(texto), "%.2f", valor);
+        if (n > 0) escrever_bytes(escritor, texto, (size_t)n < sizeof(texto) ? (size_t)n : sizeof(texto) - 1);
+        return;
+    }
+    
+    unsigned long long centesimos = (unsigned long long)escalado;
+    double fracao = escalado - (double)centesimos;
+    if (fracao > 0.5 || (fracao == 0.5 && (centesimos & 1))) centesimos++;
+    
+    char digitos[32];
+    char* fim = digitos + sizeof(digitos);
+    char* inicio = fim;
+    *--inicio = (char)('0' + centesimos % 10);
+    *--inicio = (char)('0' + centesimos / 10 % 10);
+    *--inicio = '.';
+    inicio = formatar_sem_sinal(inicio, centesimos / 100);
+    if (signbit(valor)) *--inicio = '-';
+    escrever_bytes(escritor, inicio, fim - inicio);
+}
+
+// Tamanho da sequncia UTF-8 vlida que comea em p, ou 0 se no houver
+static int comprimento_utf8(const unsigned char* p) {
+    unsigned char c = p[0];
+    if (c >= 0xC2 && c <= 0xDF) {
+        return (p[1] & 0xC0) == 0x80 ? 2 : 0;
+    }
+    if (c >= 0xE0 && c <= 0xEF) {
+        unsigned char minimo = (c == 0xE0) ? 0xA0 : 0x80;
+        unsigned char maximo = (c == 0xED) ? 0x9F : 0xBF;
+        if (p[1] < minimo || p[1] > maximo) return 0;
+        return (p[2] & 0xC0) == 0x80 ? 3 : 0;
+    }
+    if (c >= 0xF0 && c <= 0xF4) {
+        unsigned char minimo = (c == 0xF0) ? 0x90 : 0x80;
+        unsigned char maximo = (c == 0xF4) ? 0x8F : 0xBF;
+        if (p[1] < minimo || p[1] > maximo) return 0;
+        if ((p[2] & 0xC0) != 0x80) return 0;
+        return (p[3] & 0xC0) == 0x80 ? 4 : 0;
+    }
+    return 0;
+}
+
+void escrever_string_json(EscritorSaida* escritor, const char* texto) {
+    static const char hexa[] = "0123456789abcdef";
+    if (!escritor) return;
+    
+    escrever_bytes(escritor, "\"", 1);
+    const unsigned char* p = (const unsigned char*)(texto ? texto : "");
+    
+    for (;;) {
+        // Trecho sem nada a escapar vai numa cpia s
+        const unsigned char* inicio = p;
+        while (classe_json[*p] == JSON_LITERAL) p++;
+        escrever_bytes(escritor, (const char*)inicio, p - inicio);
+        
+        unsigned char c = *p;
+        char* saida;
+        int n;
+        switch (classe_json[c]) {
+            case JSON_FIM:
+                escrever_bytes(escritor, "\"", 1);
+                return;
+            case JSON_CURTO:
+                saida = reservar(escritor, 2);
+                saida[0] = '\\';
+                saida[1] = escape_json[c];
+                escritor->usado += 2;
+                p++;
+                break;
+            case JSON_CONTROLE:
+                saida = reservar(escritor, 6);
+                memcpy(saida, "\\u00", 4);
+                saida[4] = hexa[c >> 4];
+                saida[5] = hexa[c & 0xF];
+                escritor->usado += 6;
+                p++;
+                break;
+            default:
+                n = comprimento_utf8(p);
+                if (n > 0) {
+                    escrever_bytes(escritor, (const char*)p, n);
+                    p += n;
+                } else {
+                    // Byte solto: lido como Latin-1, sai em UTF-8
+                    saida = reservar(escritor, 2);
+                    saida[0] = (char)(0xC0 | (c >> 6));
+                    saida[1] = (char)(0x80 | (c & 0x3F));
+                    escritor->usado += 2;
+                    p++;
+                }
+                break;
+        }
+    }
+}
+
+void escrever_campo_csv(EscritorSaida* escritor, const char* texto) {
+    if (!escritor || !texto) return;
+    
+    const unsigned char* p = (const unsigned char*)texto;
+    size_t tamanho = 0;
+    int aspas = 0;
+    while (p[tamanho]) aspas |= exige_aspas_csv[p[tamanho++]];
+    
+    if (!aspas) {
+        escrever_bytes(escritor, texto, tamanho);
+        return;
+    }
+    
+    // Entre aspas: cada aspa interna vira duas
+    escrever_bytes(escritor, "\"", 1);
+    const char* inicio = texto;
+    const char* aspa;
+    while ((aspa = strchr(inicio, '"')) != NULL) {
+        escrever_bytes(escritor, inicio, aspa - inicio + 1);
+        escrever_bytes(escritor, "\"", 1);
+        inicio = aspa + 1;
+    }
+    escrever_texto(escritor, inicio);
+    escrever_bytes(escritor, "\"", 1);
+}
@@ -0,0 +1,49 @@
+#ifndef ESCRITOR_SAIDA_H
+#define ESCRITOR_SAIDA_H
+
+#include <stdio.h>
+#include <stddef.h>
+
+// ================= ESCRITOR BUFFERIZADO DE SADA =================
+
+#define TAMANHO_BUFFER_ESCRITOR (1 << 20)  // Bloco padro: 1 MiB
+
+// Recebe cada bloco cheio (e o resto no fechamento); retorna 1 se consumiu tudo
+typedef int (*DestinoBlocoSaida)(const char* bloco, size_t tamanho, void* contexto);
+
+// Acumula a sada num buffer grande e s a entrega em blocos inteiros, seja
+// para um arquivo, seja para um destino qualquer (pipe, socket, memria)
+typedef struct EscritorSaida {
+    char* buffer;               // Bloco em montagem
+    size_t capacidade;          // Tamanho do bloco
+    size_t usado;               // Bytes j montados
+    FILE* arquivo;              // Destino em arquivo (NULL = usa a funo abaixo)
+    DestinoBlocoSaida destino;  // Destino por blocos
+    void* contexto;             // Repassado ao destino
+    int erro;                   // 1 = alguma entrega falhou
+} EscritorSaida;
+
+// Abre filename para escrita; tamanho_buffer 0 usa o padro
+EscritorSaida* criar_escritor_arquivo(const char* filename, size_t tamanho_buffer);
+// Entrega a sada em blocos de at tamanho_buffer bytes para destino
+EscritorSaida* criar_escritor_blocos(DestinoBlocoSaida destino, void* contexto, size_t tamanho_buffer);
+// Entrega o que estiver montado; retorna 0 se alguma entrega falhou
+int descarregar_escritor(EscritorSaida* escritor);
+// Descarrega, fecha o arquivo e libera; retorna 1 se toda a sada foi entregue
+int fechar_escritor(EscritorSaida* escritor);
+
+// Escrita sem formatao
+void escrever_bytes(EscritorSaida* escritor, const char* dados, size_t tamanho);
+void escrever_texto(EscritorSaida* escritor, const char* texto);
+void escrever_inteiro(EscritorSaida* escritor, int valor);
+// Mesmo texto de printf("%.2f", valor)
+void escrever_decimal(EscritorSaida* escritor, float valor);
+
+// String JSON entre aspas: escapa aspas, barra e controles; bytes que no
+// formam UTF-8 vlido so tratados como Latin-1 e convertidos
+void escrever_string_json(EscritorSaida* escritor, const char* texto);
+// Campo CSV separado por ';': vai entre aspas (com aspas dobradas) s se
+// tiver separador, aspas ou quebra de linha
+void escrever_campo_csv(EscritorSaida* escritor, const char* texto);
+
+#endif
@@ -6,6 +6,8 @@
 #include <stdbool.h>
 // Inclui biblioteca para manipulao de tempo
 #include <time.h>
+// Inclui os contineres tipados gerados por macro
+#include "colecoes.h"
 
 // Definio de constantes para tamanhos mximos
 #define MAX_NOME 100      // Tamanho mximo para nomes
@@ -21,6 +23,15 @@ typedef enum {
     PRIORIDADE_URGENTE = 2    // Grvidas, deficientes fsicos graves
 } TipoPrioridade;
 
+#define TOTAL_PRIORIDADES 3   // Nmero de valores de TipoPrioridade
+
+// Polticas de atendimento entre a fila prioritria e a fila normal do CAP
+typedef enum {
+    POLITICA_PRIORIDADE_ESTRITA = 0,    // Prioritrios sempre primeiro
+    POLITICA_ROUND_ROBIN_PONDERADO = 1, // N prioritrios para cada eleitor normal
+    POLITICA_ENVELHECIMENTO = 2         // Normal promovido aps tempo mximo de espera
+} PoliticaAtendimento;
+
 // Tipos de ns para rvores binrias
 typedef enum {
     TIPO_CANDIDATO,   // Tipo para ns de candidatos
@@ -47,17 +58,93 @@ typedef struct NoArvoreResultados {
     struct NoArvoreResultados* esquerda;  // Ponteiro para filho esquerdo
     struct NoArvoreResultados* direita;   // Ponteiro para filho direito
     int altura; // Para rvore AVL (balanceamento)
+    int tamanho;    // Ns nesta subrvore (inclui o prprio)
+    int soma_votos; // Votos somados de toda a subrvore
+    short em_bloco; // 1 = veio da carga em lote, liberado s com a rvore
 } NoArvoreResultados;
 
+// N do ndice de ranking: AVL ordenada por (votos desc, id) com o tamanho
+// da subrvore, para achar posio e k-simo colocado em O(log n)
+typedef struct NoRanking {
+    int votos;                    // Votos do resultado indexado
+    int id;                       // ID do resultado na rvore principal
+    ResultadoVotacao* resultado;  // Resultado indexado (endereo estvel)
+    struct NoRanking* esquerda;   // Mais votados (ou mesmo total, menor ID)
+    struct NoRanking* direita;    // Menos votados (ou mesmo total, maior ID)
+    int altura;                   // Altura AVL
+    int tamanho;                  // Ns nesta subrvore
+} NoRanking;
+
+// Entrada do ndice de nomes (endereamento aberto, sondagem linear)
+typedef struct EntradaIndiceNomes {
+    unsigned int hash;            // Hash do nome, evita strcmp em colises
+    ResultadoVotacao* resultado;  // NULL = posio livre
+} EntradaIndiceNomes;
+
+// ndice opcional nome -> resultado de uma rvore de resultados
+typedef struct IndiceNomes {
+    EntradaIndiceNomes* entradas; // Tabela com capacidade potncia de 2
+    int capacidade;               // Posies na tabela
+    int quantidade;               // Posies ocupadas
+} IndiceNomes;
+
 // rvore Binria de Resultados
 typedef struct ArvoreResultados {
     NoArvoreResultados* raiz;     // Ponteiro para raiz da rvore
+    NoRanking* ranking;           // ndice secundrio por votos
+    ResultadoVotacao* lider;      // Primeiro no ranking (NULL = rvore vazia)
+    ResultadoVotacao* vice;       // Segundo no ranking (NULL = menos de dois)
+    ResultadoVotacao* ultimo_colocado; // ltimo no ranking
+    int percentuais_pendentes;    // 1 = votos mudaram desde o ltimo clculo de percentuais
+    IndiceNomes* indice_nomes;    // Opcional: busca por nome em O(1) (NULL = desativado)
+    NoArvoreResultados* bloco_nos; // Carga em lote: bloco nico com os ns das duas rvores
+    NoRanking* bloco_ranking;     // Incio dos ns de ranking dentro do bloco
+    int nos_no_bloco;             // Ns de cada tipo no bloco (0 = sem bloco)
     int total_votos;              // Total de votos na rvore
     int total_eleitores;          // Total de eleitores
     float participacao;           // Percentual de participao
     TipoNoArvore tipo_arvore;     // Tipo de organizao da rvore
 } ArvoreResultados;
 
+// Ordens de percurso da rvore de resultados
+typedef enum {
+    PERCURSO_EM_ORDEM,            // IDs crescentes
+    PERCURSO_EM_ORDEM_REVERSA,    // IDs decrescentes
+    PERCURSO_PRE_ORDEM,           // N, esquerda, direita
+    PERCURSO_POS_ORDEM            // Esquerda, direita, n
+} OrdemPercurso;
+
+// Uma AVL com at 2^31 ns tem altura <= 45; cada nvel empilha no mximo
+// dois pendentes alm do prprio n, ento 128 entradas sempre bastam
+#define TAMANHO_PILHA_ITERADOR 128
+
+// Entrada da pilha explcita do iterador
+typedef struct EntradaIterador {
+    NoArvoreResultados* no;       // N pendente
+    short profundidade;           // Profundidade do n (raiz = 0)
+    short expandido;              // 1 = filhos j empilhados, visitar o n
+} EntradaIterador;
+
+// Iterador sem recurso sobre a rvore de resultados. O n devolvido no 
+// mais referenciado pelo iterador, ento pode ser liberado durante o percurso.
+typedef struct IteradorArvore {
+    EntradaIterador pilha[TAMANHO_PILHA_ITERADOR];
+    int topo;                     // Entradas ocupadas na pilha
+    OrdemPercurso ordem;          // Ordem do percurso
+    int filtrar;                  // 1 = devolver s ns do tipo abaixo
+    TipoNoArvore tipo;            // Tipo aceito quando filtrar = 1
+    int profundidade;             // Profundidade do ltimo n devolvido
+} IteradorArvore;
+
+// Iterador sobre o ndice de ranking restrito a uma faixa de votos. Devolve
+// do mais votado para o menos votado; inseres, remoes e votos novos na
+// rvore invalidam o iterador.
+typedef struct IteradorFaixaVotos {
+    NoRanking* pilha[TAMANHO_PILHA_ITERADOR];
+    int topo;                     // Ns pendentes na pilha
+    int votos_min;                // Limite inferior da faixa (inclusivo)
+} IteradorFaixaVotos;
+
 // Estrutura para Eleitor
 typedef struct Eleitor {
     int id;                     // ID nico do eleitor
@@ -70,9 +157,33 @@ typedef struct Eleitor {
     struct Eleitor* proximo;    // Ponteiro para prximo eleitor (lista ligada)
 } Eleitor;
 
+// Eleitores atendidos: bitmap por ID + log de IDs em blocos, por CAP
+#define BITS_BLOCO_ATENDIDOS 10
+#define IDS_POR_BLOCO_ATENDIDOS (1 << BITS_BLOCO_ATENDIDOS)  // 1024 IDs por bloco
+
+DEFINIR_VETOR(BitsAtendidos, unsigned long long, bits_atendidos)
+DEFINIR_VETOR(DiretorioIds, int*, diretorio_ids)
+
+typedef struct AtendidosCAP {
+    int id_cap;                 // CAP dono deste registro
+    BitsAtendidos bitmap;       // Bit id_eleitor ligado = j atendido neste CAP
+    DiretorioIds log;           // IDs na ordem de atendimento (blocos fixos)
+    int total;                  // Eleitores atendidos neste CAP
+} AtendidosCAP;
+
+DEFINIR_VETOR(VetorAtendidosCAP, AtendidosCAP*, atendidos_caps)
+
+typedef struct RegistroAtendidos {
+    VetorAtendidosCAP por_cap;  // Registros dos CAPs, na ordem do primeiro atendimento
+    int* indice_caps;           // Disperso ID do CAP -> posio em por_cap + 1 (0 = livre)
+    int capacidade_indice;      // Tamanho de indice_caps (potncia de 2)
+    int total;                  // Eleitores atendidos em todos os CAPs
+} RegistroAtendidos;
+
 // Estrutura para N da Fila
 typedef struct NoFila {
     Eleitor* eleitor;           // Ponteiro para eleitor
+    long long entrada_ns;       // Instante de entrada na fila (relgio monotnico)
     struct NoFila* proximo;     // Ponteiro para prximo n
 } NoFila;
 
@@ -83,18 +194,40 @@ typedef struct Fila {
     int tamanho;                // Nmero de elementos na fila
 } Fila;
 
+// Histograma de tempos de espera (estilo HDR: memria fixa, erro relativo ~3%)
+// Valores em microssegundos; abaixo de 2^(BITS_SUB+1) cada valor tem seu balde,
+// acima disso cada potncia de 2  dividida em 2^BITS_SUB baldes
+#define HISTOGRAMA_BITS_SUB 5     // 32 sub-baldes por potncia de 2
+#define HISTOGRAMA_BITS_MAX 37    // Espera mxima representvel: 2^37 us (~38 horas)
+#define HISTOGRAMA_BALDES ((HISTOGRAMA_BITS_MAX - HISTOGRAMA_BITS_SUB + 1) << HISTOGRAMA_BITS_SUB)
+
+typedef struct HistogramaEspera {
+    unsigned int contagens[HISTOGRAMA_BALDES]; // Contagem por balde
+    long long total;            // Eleitores que saram da fila
+    long long soma_us;          // Soma dos tempos de espera
+    long long maximo_us;        // Maior tempo de espera observado
+} HistogramaEspera;
+
 // Estrutura para N da Pilha
 typedef struct NoPilha {
     void* dado;                 // Dado genrico (pode ser qualquer tipo)
     struct NoPilha* abaixo;     // Ponteiro para elemento abaixo
+    struct NoPilha* acima;      // Ponteiro para elemento acima (NULL no topo)
 } NoPilha;
 
 // Estrutura para Pilha (LIFO)
 typedef struct Pilha {
     NoPilha* topo;              // Ponteiro para topo da pilha
+    NoPilha* base;              // Ponteiro para o elemento mais antigo
     int tamanho;                // Nmero de elementos na pilha
 } Pilha;
 
+// Cursor somente leitura sobre uma Pilha (no aloca nem altera a pilha)
+typedef struct CursorPilha {
+    NoPilha* atual;             // Elemento corrente (NULL = fim)
+    bool do_topo;               // true = topo para base; false = base para topo
+} CursorPilha;
+
 // Estrutura para Voto
 typedef struct Voto {
     int id_eleitor;             // ID do eleitor que votou
@@ -104,23 +237,79 @@ typedef struct Voto {
     int numero_urna;            // Nmero da urna utilizada
 } Voto;
 
-// Estrutura para Operao (log do sistema)
+// Pilha de votos: blocos de tamanho fixo com os votos guardados por valor
+#define BITS_BLOCO_VOTOS 10
+#define VOTOS_POR_BLOCO (1 << BITS_BLOCO_VOTOS)  // 1024 votos por bloco
+
+// Diretrio de blocos: os votos no mudam de endereo quando a pilha cresce
+DEFINIR_VETOR(DiretorioVotos, Voto*, diretorio_votos)
+
+typedef struct PilhaVotos {
+    DiretorioVotos blocos;      // Blocos de VOTOS_POR_BLOCO votos
+    int tamanho;                // Nmero de votos na pilha
+    
+    // Prefixo carregado por mmap (votos mais antigos, usados sem cpia)
+    Voto* mapeados;             // Primeiro voto dentro do mapeamento
+    int num_mapeados;           // Votos servidos pelo mapeamento
+    void* mapa;                 // Incio do mapeamento (NULL se no houver)
+    size_t tamanho_mapa;        // Bytes mapeados
+} PilhaVotos;
+
+// Tipos de operao registrados no histrico
+typedef enum {
+    OPERACAO_SISTEMA = 0,       // Inicializao do sistema
+    OPERACAO_ABERTURA,          // Votao iniciada
+    OPERACAO_ENCERRAMENTO,      // Votao encerrada
+    OPERACAO_CHEGADA,           // Eleitor entrou na fila do CAP
+    OPERACAO_CHAMADA,           // Eleitor chamado para votar
+    OPERACAO_VOTO,              // Voto registrado na urna
+    OPERACAO_FINALIZACAO,       // Urna liberada aps o voto
+    TOTAL_TIPOS_OPERACAO
+} TipoOperacao;
+
+#define SEM_REFERENCIA -1       // Campo da operao que no se aplica
+
+// Estrutura para Operao (log do sistema): registro binrio compacto,
+// o texto s  montado ao imprimir (ver formatar_operacao)
 typedef struct Operacao {
-    char tipo[50];              // Tipo da operao
-    char descricao[200];        // Descrio detalhada
-    time_t timestamp;           // Data/hora da operao
+    unsigned int timestamp;     // Data/hora da operao (segundos, 32 bits)
     int usuario_id;             // ID do usurio que realizou
+    int id_eleitor;             // Eleitor envolvido (ou SEM_REFERENCIA)
+    int numero_candidato;       // Candidato votado (ou SEM_REFERENCIA)
+    int id_cap;                 // CAP envolvido (ou SEM_REFERENCIA)
+    int numero_urna;            // Urna envolvida (ou SEM_REFERENCIA)
+    unsigned char tipo;         // TipoOperacao
 } Operacao;
 
+// Fila tipada de operaes (buffer circular)
+DEFINIR_FILA(FilaOperacoes, Operacao, fila_operacoes)
+
+// Histrico de operaes (capacidade fixa: a mais antiga sai quando enche)
+typedef struct HistoricoOperacoes {
+    FilaOperacoes registros;    // Operaes, da mais antiga  mais recente
+    int capacidade;             // Nmero mximo de operaes guardadas
+    struct DiarioOperacoes* diario; // Dirio em disco (opcional)
+} HistoricoOperacoes;
+
 // Estrutura para Urna Eletrnica
 typedef struct Urna {
     int numero;                 // Nmero da urna
     int cap_id;                 // ID do CAP onde est a urna
     int votos_registrados;      // Nmero de votos registrados
+    int votos_apurados;         // Votos do histrico j aplicados  apurao
     bool ativa;                 // Status da urna (ativa/inativa)
-    Pilha* historico_votos;     // Pilha com histrico de votos
+    PilhaVotos* historico_votos; // Pilha com histrico de votos
 } Urna;
 
+// Estrutura com os CAPs alterados desde a ltima apurao
+typedef struct PendenciasApuracao {
+    int* caps;                  // Posies em ListaCAPs dos CAPs pendentes
+    int quantidade;             // Nmero de CAPs pendentes
+    int capacidade;             // Capacidade do array de posies
+    bool invalida;              // Posies perdidas: s a apurao completa serve
+    const void* dono;           // Sistema de apurao que fez a ltima apurao
+} PendenciasApuracao;
+
 // Estrutura para Candidato
 typedef struct Candidato {
     int numero;                 // Nmero do candidato
@@ -142,6 +331,12 @@ typedef struct CAP {
     Fila* fila_normal;          // Fila de eleitores normais
     Fila* fila_prioritaria;     // Fila de eleitores prioritrios
     
+    // Poltica de atendimento das filas
+    PoliticaAtendimento politica_atendimento;
+    int parametro_politica;     // Peso (round-robin) ou limite de espera em segundos (envelhecimento)
+    int prioritarios_seguidos;  // Prioritrios atendidos desde o ltimo eleitor normal
+    HistogramaEspera* espera;   // Tempos de espera por TipoPrioridade (NULL at o primeiro atendimento)
+    
     // Array de urnas
     Urna** urnas;               // Array de ponteiros para urnas
     
@@ -151,6 +346,11 @@ typedef struct CAP {
     
     // Resultados deste CAP
     ArvoreResultados* resultados_cap; // rvore com resultados do CAP
+    
+    // Apurao incremental
+    PendenciasApuracao* pendencias; // Pendncias da lista onde est o CAP
+    int posicao;                // Posio do CAP na lista
+    bool pendente;              // CAP j consta nas pendncias
 } CAP;
 
 // Estruturas para listas sequenciais (arrays dinmicos)
@@ -167,6 +367,7 @@ typedef struct ListaCAPs {
     CAP* caps;                  // Array de CAPs
     int tamanho;                // Nmero atual de CAPs
     int capacidade;             // Capacidade mxima do array
+    PendenciasApuracao* pendencias; // CAPs alterados desde a ltima apurao
 } ListaCAPs;
 
 // Estrutura para N da Lista Ligada de Eleitores
@@ -190,7 +391,7 @@ typedef struct SistemaEleitoral {
     ArvoreResultados* arvore_candidatos; // rvore de resultados de candidatos
     ArvoreResultados* arvore_caps;      // rvore de resultados de CAPs
     ArvoreResultados* arvore_regioes;   // rvore de resultados por regio
-    Pilha* historico_operacoes;         // Pilha com histrico de operaes
+    HistoricoOperacoes* historico_operacoes; // Histrico de operaes
     bool votacao_ativa;                 // Status da votao
     int usuario_logado;                 // ID do usurio logado
 } SistemaEleitoral;
@@ -1,7 +1,10 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #include "filas.h"
+#include "caps.h"
 
 // ================= IMPLEMENTAO FILA NORMAL =================
 
@@ -32,6 +35,7 @@ int enfileirar(Fila* fila, Eleitor* eleitor) {
     if (!novo_no) return 0;
     
     novo_no->eleitor = eleitor;
+    novo_no->entrada_ns = tempo_monotonico_ns();
     novo_no->proximo = NULL;
     
     if (fila_vazia(fila)) {
@@ -113,37 +117,39 @@ void imprimir_fila(Fila* fila) {
 int mover_eleitor_fila(Fila* origem, Fila* destino, int id_eleitor) {
     if (!origem || !destino || fila_vazia(origem)) return 0;
     
-    // Se o eleitor estiver na frente, basta desenfileirar e enfileirar
-    Eleitor* frente = frente_fila(origem);
-    if (frente && frente->id == id_eleitor) {
-        Eleitor* eleitor = desenfileirar(origem);
-        if (eleitor) {
-            return enfileirar(destino, eleitor);
-        }
+    // Procurar o n e relig-lo no destino, preservando o instante de entrada
+    NoFila* anterior = NULL;
+    NoFila* atual = origem->frente;
+    
+    while (atual != NULL && atual->eleitor->id != id_eleitor) {
+        anterior = atual;
+        atual = atual->proximo;
     }
     
-    // Buscar em outras posies (mais complexo)
-    Fila* temp = criar_fila();
-    int encontrado = 0;
+    if (atual == NULL) return 0;
     
-    while (!fila_vazia(origem)) {
-        Eleitor* eleitor = desenfileirar(origem);
-        if (eleitor->id == id_eleitor) {
-            enfileirar(destino, eleitor);
-            encontrado = 1;
-            break;
-        } else {
-            enfileirar(temp, eleitor);
-        }
+    // Remover da origem
+    if (anterior) {
+        anterior->proximo = atual->proximo;
+    } else {
+        origem->frente = atual->proximo;
     }
+    if (origem->tras == atual) {
+        origem->tras = anterior;
+    }
+    origem->tamanho--;
     
-    // Restaurar a fila original
-    while (!fila_vazia(temp)) {
-        enfileirar(origem, desenfileirar(temp));
+    // Inserir no final do destino
+    atual->proximo = NULL;
+    if (fila_vazia(destino)) {
+        destino->frente = atual;
+    } else {
+        destino->tras->proximo = atual;
     }
+    destino->tras = atual;
+    destino->tamanho++;
     
-    destruir_fila(temp);
-    return encontrado;
+    return 1;
 }
 
 int buscar_na_fila(Fila* fila, int id_eleitor) {
@@ -322,24 +328,83 @@ int adicionar_eleitor_cap_fila(CAP* cap, Eleitor* eleitor) {
     return 0;
 }
 
+// Seleo da fila a atender, uma funo por poltica
+typedef Fila* (*SelecaoFila)(CAP* cap, long long agora);
+
+static Fila* selecionar_prioridade_estrita(CAP* cap, long long agora) {
+    (void)agora;
+    
+    // Primeiro atender prioritrios, depois normais
+    if (!fila_vazia(cap->fila_prioritaria)) return cap->fila_prioritaria;
+    if (!fila_vazia(cap->fila_normal)) return cap->fila_normal;
+    return NULL;
+}
+
+static Fila* selecionar_round_robin_ponderado(CAP* cap, long long agora) {
+    (void)agora;
+    
+    // At parametro_politica prioritrios seguidos, depois um normal
+    if (!fila_vazia(cap->fila_prioritaria) &&
+        (fila_vazia(cap->fila_normal) || cap->prioritarios_seguidos < cap->parametro_politica)) {
+        return cap->fila_prioritaria;
+    }
+    if (!fila_vazia(cap->fila_normal)) return cap->fila_normal;
+    return NULL;
+}
+
+static Fila* selecionar_envelhecimento(CAP* cap, long long agora) {
+    // Eleitor normal que esperou alm do limite passa  frente
+    if (!fila_vazia(cap->fila_normal)) {
+        long long limite_ns = (long long)cap->parametro_politica * 1000000000LL;
+        if (agora - entrada_frente_fila(cap->fila_normal) >= limite_ns) {
+            return cap->fila_normal;
+        }
+    }
+    return selecionar_prioridade_estrita(cap, agora);
+}
+
+static const SelecaoFila selecoes_fila[] = {
+    selecionar_prioridade_estrita,      // POLITICA_PRIORIDADE_ESTRITA
+    selecionar_round_robin_ponderado,   // POLITICA_ROUND_ROBIN_PONDERADO
+    selecionar_envelhecimento           // POLITICA_ENVELHECIMENTO
+};
+
 Eleitor* proximo_eleitor_cap(CAP* cap) {
     if (!cap) return NULL;
     
-    // Primeiro atender prioritrios
-    if (cap->fila_prioritaria && !fila_vazia(cap->fila_prioritaria)) {
-        cap->eleitores_na_fila--;
-        cap->eleitores_atendidos++;
-        return desenfileirar(cap->fila_prioritaria);
+    PoliticaAtendimento politica = cap->politica_atendimento;
+    if (politica < POLITICA_PRIORIDADE_ESTRITA || politica > POLITICA_ENVELHECIMENTO) {
+        politica = POLITICA_PRIORIDADE_ESTRITA;
     }
     
-    // Depois atender normais
-    if (cap->fila_normal && !fila_vazia(cap->fila_normal)) {
-        cap->eleitores_na_fila--;
-        cap->eleitores_atendidos++;
-        return desenfileirar(cap->fila_normal);
+    long long agora = tempo_monotonico_ns();
+    Fila* fila = selecoes_fila[politica](cap, agora);
+    if (!fila) return NULL;
+    
+    long long espera_ns = agora - entrada_frente_fila(fila);
+    Eleitor* eleitor = desenfileirar(fila);
+    
+    // Histogramas s existem nos CAPs que j atenderam algum; sem memria
+    // o atendimento segue, s sem a medio
+    if (!cap->espera) {
+        cap->espera = (HistogramaEspera*)calloc(TOTAL_PRIORIDADES, sizeof(HistogramaEspera));
+    }
+    if (cap->espera) {
+        int classe = eleitor->prioridade;
+        if (classe < 0 || classe >= TOTAL_PRIORIDADES) classe = PRIORIDADE_NORMAL;
+        registrar_espera_histograma(&cap->espera[classe], espera_ns);
     }
     
-    return NULL;
+    if (fila == cap->fila_prioritaria) {
+        cap->prioritarios_seguidos++;
+    } else {
+        cap->prioritarios_seguidos = 0;
+    }
+    
+    cap->eleitores_na_fila--;
+    cap->eleitores_atendidos++;
+    marcar_cap_pendente(cap);
+    return eleitor;
 }
 
 int total_eleitores_na_fila_cap(CAP* cap) {
@@ -384,6 +449,149 @@ void imprimir_filas_cap(CAP* cap) {
     printf("  Total na fila: %d\n", total_eleitores_na_fila_cap(cap));
     printf("  Prioritarios: %d\n", eleitores_prioritarios_na_fila_cap(cap));
     printf("  Eleitores atendidos: %d\n", cap->eleitores_atendidos);
+    
+    imprimir_estatisticas_espera_cap(cap);
+}
+
+// ================= POLTICAS DE ATENDIMENTO =================
+
+void inicializar_atendimento_cap(CAP* cap) {
+    if (!cap) return;
+    
+    cap->politica_atendimento = POLITICA_PRIORIDADE_ESTRITA;
+    cap->parametro_politica = 0;
+    cap->prioritarios_seguidos = 0;
+    cap->espera = NULL;
+}
+
+void liberar_atendimento_cap(CAP* cap) {
+    if (!cap) return;
+    
+    free(cap->espera);
+    cap->espera = NULL;
+}
+
+void definir_politica_atendimento_cap(CAP* cap, PoliticaAtendimento politica, int parametro) {
+    if (!cap) return;
+    
+    // Parmetro no positivo usa o valor padro da poltica
+    if (parametro <= 0) {
+        switch (politica) {
+            case POLITICA_ROUND_ROBIN_PONDERADO: parametro = PESO_PRIORITARIO_PADRAO; break;
+            case POLITICA_ENVELHECIMENTO: parametro = LIMITE_ESPERA_PADRAO_SEGUNDOS; break;
+            default: parametro = 0;
+        }
+    }
+    
+    cap->politica_atendimento = politica;
+    cap->parametro_politica = parametro;
+    cap->prioritarios_seguidos = 0;
+}
+
+const char* nome_politica_atendimento(PoliticaAtendimento politica) {
+    switch (politica) {
+        case POLITICA_PRIORIDADE_ESTRITA: return "PRIORIDADE ESTRITA";
+        case POLITICA_ROUND_ROBIN_PONDERADO: return "ROUND-ROBIN PONDERADO";
+        case POLITICA_ENVELHECIMENTO: return "ENVELHECIMENTO";
+        default: return "DESCONHECIDA";
+    }
+}
+
+long long tempo_monotonico_ns() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+long long entrada_frente_fila(Fila* fila) {
+    if (!fila || fila_vazia(fila)) return 0;
+    return fila->frente->entrada_ns;
+}
+
+// ================= HISTOGRAMA DE ESPERA =================
+
+// ndice do balde de um valor em microssegundos
+static inline int balde_histograma(unsigned long long valor) {
+    if (valor < (2ULL << HISTOGRAMA_BITS_SUB)) return (int)valor;
+    
+    int bit_mais_alto = 63 - __builtin_clzll(valor);
+    int deslocamento = bit_mais_alto - HISTOGRAMA_BITS_SUB;
+    return (deslocamento << HISTOGRAMA_BITS_SUB) + (int)(valor >> deslocamento);
+}
+
+// Maior valor que cai no balde (inverso de balde_histograma)
+static long long limite_superior_balde(int balde) {
+    if (balde < (2 << HISTOGRAMA_BITS_SUB)) return balde;
+    
+    int deslocamento = (balde >> HISTOGRAMA_BITS_SUB) - 1;
+    long long base = (long long)(balde - (deslocamento << HISTOGRAMA_BITS_SUB));
+    return ((base + 1) << deslocamento) - 1;
+}
+
+void registrar_espera_histograma(HistogramaEspera* histograma, long long espera_ns) {
+    if (!histograma) return;
+    
+    long long espera_us = espera_ns > 0 ? espera_ns / 1000 : 0;
+    long long limite_us = (1LL << HISTOGRAMA_BITS_MAX) - 1;
+    if (espera_us > limite_us) espera_us = limite_us;
+    
+    histograma->contagens[balde_histograma((unsigned long long)espera_us)]++;
+    histograma->total++;
+    histograma->soma_us += espera_us;
+    if (espera_us > histograma->maximo_us) {
+        histograma->maximo_us = espera_us;
+    }
+}
+
+long long percentil_histograma(HistogramaEspera* histograma, double percentil) {
+    if (!histograma || histograma->total == 0) return 0;
+    
+    // Posio (1..total) do elemento que corresponde ao percentil
+    long long alvo = (long long)(percentil / 100.0 * histograma->total + 0.5);
+    if (alvo < 1) alvo = 1;
+    if (alvo > histograma->total) alvo = histograma->total;
+    
+    long long acumulado = 0;
+    for (int i = 0; i < HISTOGRAMA_BALDES; i++) {
+        acumulado += histograma->contagens[i];
+        if (acumulado >= alvo) {
+            long long valor = limite_superior_balde(i);
+            return valor < histograma->maximo_us ? valor : histograma->maximo_us;
+        }
+    }
+    
+    return histograma->maximo_us;
+}
+
+void imprimir_estatisticas_espera_cap(CAP* cap) {
+    if (!cap) return;
+    
+    static const char* nomes_classe[TOTAL_PRIORIDADES] = { "Normal", "Alta", "Urgente" };
+    
+    printf("\nTempo de espera (politica: %s", nome_politica_atendimento(cap->politica_atendimento));
+    if (cap->politica_atendimento != POLITICA_PRIORIDADE_ESTRITA) {
+        printf(", parametro: %d", cap->parametro_politica);
+    }
+    printf("):\n");
+    printf("  %-8s | %-9s | %-9s | %-9s | %-9s | %-9s\n",
+           "Classe", "Atendidos", "p50 (s)", "p90 (s)", "p99 (s)", "Max (s)");
+    
+    for (int i = 0; i < TOTAL_PRIORIDADES; i++) {
+        HistogramaEspera* histograma = cap->espera ? &cap->espera[i] : NULL;
+        if (!histograma || histograma->total == 0) {
+            printf("  %-8s | %-9d | %-9s | %-9s | %-9s | %-9s\n",
+                   nomes_classe[i], 0, "-", "-", "-", "-");
+            continue;
+        }
+        
+        printf("  %-8s | %-9lld | %-9.2f | %-9.2f | %-9.2f | %-9.2f\n",
+               nomes_classe[i],
+               histograma->total,
+               percentil_histograma(histograma, 50) / 1e6,
+               percentil_histograma(histograma, 90) / 1e6,
+               percentil_histograma(histograma, 99) / 1e6,
+               histograma->maximo_us / 1e6);
+    }
 }
 
 void simular_processamento_fila(CAP* cap, int num_eleitores_processar) {
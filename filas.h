@@ -58,6 +58,24 @@ int total_eleitores_na_fila_cap(CAP* cap);
 int eleitores_prioritarios_na_fila_cap(CAP* cap);
 void imprimir_filas_cap(CAP* cap);
 
+// ================= POLTICAS DE ATENDIMENTO =================
+
+#define PESO_PRIORITARIO_PADRAO 3          // Prioritrios por eleitor normal (round-robin)
+#define LIMITE_ESPERA_PADRAO_SEGUNDOS 600  // Espera mxima antes da promoo (envelhecimento)
+
+// Configurao da poltica usada por proximo_eleitor_cap
+void inicializar_atendimento_cap(CAP* cap);
+void liberar_atendimento_cap(CAP* cap);
+void definir_politica_atendimento_cap(CAP* cap, PoliticaAtendimento politica, int parametro);
+const char* nome_politica_atendimento(PoliticaAtendimento politica);
+
+// Medio de tempo de espera
+long long tempo_monotonico_ns();
+long long entrada_frente_fila(Fila* fila);
+void registrar_espera_histograma(HistogramaEspera* histograma, long long espera_ns);
+long long percentil_histograma(HistogramaEspera* histograma, double percentil);
+void imprimir_estatisticas_espera_cap(CAP* cap);
+
 // ================= SIMULAO DE VOTAO =================
 
 void simular_processamento_fila(CAP* cap, int num_eleitores_processar);
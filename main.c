@@ -7,6 +7,7 @@
 #include "eleitores.h"
 #include "filas.h"
 #include "pilhas.h"
+#include "diario_operacoes.h"
 #include "votacao.h"
 #include "arvore_resultados.h"
 #include "apuracao.h"
@@ -79,7 +80,8 @@ int main() {
     if (sistema.arvore_candidatos) destruir_arvore_resultados(sistema.arvore_candidatos);
     if (sistema.arvore_caps) destruir_arvore_resultados(sistema.arvore_caps);
     if (sistema.arvore_regioes) destruir_arvore_resultados(sistema.arvore_regioes);
-    if (sistema.historico_operacoes) destruir_pilha(sistema.historico_operacoes);
+    if (sistema.historico_operacoes) destruir_historico_operacoes(sistema.historico_operacoes);
+    destruir_apuracao_sessao();
     
     printf("Sistema encerrado com sucesso.\n");
     return 0;
@@ -99,7 +101,7 @@ void inicializar_sistema() {
     sistema.arvore_regioes = criar_arvore_resultados(TIPO_REGIAO);
     
     // Inicializar histrico
-    sistema.historico_operacoes = criar_pilha_operacoes();
+    sistema.historico_operacoes = criar_historico_operacoes(CAPACIDADE_HISTORICO);
     
     // Inicializar estado
     sistema.votacao_ativa = false;
@@ -328,6 +330,7 @@ void menu_votacao() {
         printf("5. Simular Votacao em Lote\n");
         printf("6. Ver Filas dos CAPs\n");
         printf("7. Ver Historico de Operacoes\n");
+        printf("8. Definir Politica de Atendimento\n");
         printf("0. Voltar\n");
         printf("===============================================\n");
         printf("Escolha: ");
@@ -397,6 +400,25 @@ void menu_votacao() {
             case 7:
                 imprimir_historico_operacoes(sistema_votacao->historico_operacoes, 10);
                 break;
+            case 8: {
+                int id_cap, politica, parametro;
+                printf("ID do CAP: ");
+                scanf("%d", &id_cap);
+                printf("Politica (0=Prioridade estrita, 1=Round-robin ponderado, 2=Envelhecimento): ");
+                scanf("%d", &politica);
+                printf("Parametro (peso ou limite em segundos, 0=padrao): ");
+                scanf("%d", &parametro);
+                
+                CAP* cap = buscar_cap_por_id(&sistema.caps, id_cap);
+                if (cap && politica >= POLITICA_PRIORIDADE_ESTRITA && politica <= POLITICA_ENVELHECIMENTO) {
+                    definir_politica_atendimento_cap(cap, (PoliticaAtendimento)politica, parametro);
+                    printf("Politica do CAP %d: %s\n", cap->id, 
+                           nome_politica_atendimento(cap->politica_atendimento));
+                } else {
+                    printf("CAP ou politica invalida!\n");
+                }
+                break;
+            }
         }
         
         if (opcao != 0) {
@@ -410,9 +432,12 @@ void menu_votacao() {
 }
 
 void menu_apuracao() {
-    SistemaApuracao* sistema_apuracao = criar_sistema_apuracao();
-    inicializar_apuracao(sistema_apuracao, &sistema.candidatos, 
-                        &sistema.caps, &sistema.eleitores);
+    SistemaApuracao* sistema_apuracao = obter_apuracao_sessao(&sistema.candidatos, 
+                                                              &sistema.caps, &sistema.eleitores);
+    if (!sistema_apuracao) {
+        printf("Memoria insuficiente para a apuracao!\n");
+        return;
+    }
     
     int opcao;
     do {
@@ -427,6 +452,7 @@ void menu_apuracao() {
         printf("6. Gerar Relatorio Completo\n");
         printf("7. Validar Integridade da Apuracao\n");
         printf("8. Exportar Resultados\n");
+        printf("9. Recontar Votos das Urnas (paralelo)\n");
         printf("0. Voltar\n");
         printf("===============================================\n");
         printf("Escolha: ");
@@ -458,6 +484,12 @@ void menu_apuracao() {
             case 8:
                 exportar_resultados_finais(sistema_apuracao, "resultados_finais.txt");
                 break;
+            case 9:
+                if (!recontar_votos_urnas(sistema_apuracao, &sistema.candidatos, 
+                                          &sistema.caps, &sistema.eleitores, 0)) {
+                    printf("Falha na recontagem das urnas!\n");
+                }
+                break;
         }
         
         if (opcao != 0) {
@@ -466,8 +498,6 @@ void menu_apuracao() {
         }
         
     } while (opcao != 0);
-    
-    destruir_sistema_apuracao(sistema_apuracao);
 }
 
 void menu_relatorios() {
@@ -481,6 +511,7 @@ void menu_relatorios() {
         printf("3. Eleitores Prioritarios\n");
         printf("4. Candidatos por Partido\n");
         printf("5. Grafico de Barras (Candidatos)\n");
+        printf("6. Consultar Diario de Operacoes\n");
         printf("0. Voltar\n");
         printf("===============================================\n");
         printf("Escolha: ");
@@ -532,11 +563,39 @@ void menu_relatorios() {
                 break;
             }
             case 5: {
-                SistemaApuracao* sistema_apuracao = criar_sistema_apuracao();
-                inicializar_apuracao(sistema_apuracao, &sistema.candidatos, 
-                                    &sistema.caps, &sistema.eleitores);
-                exibir_grafico_barras_candidatos(sistema_apuracao);
-                destruir_sistema_apuracao(sistema_apuracao);
+                SistemaApuracao* sistema_apuracao = obter_apuracao_sessao(&sistema.candidatos, 
+                                                                          &sistema.caps, &sistema.eleitores);
+                if (sistema_apuracao) exibir_grafico_barras_candidatos(sistema_apuracao);
+                break;
+            }
+            case 6: {
+                char tipo[50];
+                int usuario, minutos;
+                FiltroDiario filtro;
+                inicializar_filtro_diario(&filtro);
+                
+                printf("Tipo (SISTEMA, ABERTURA, ENCERRAMENTO, CHEGADA, CHAMADA, VOTO, FINALIZACAO; vazio = todos): ");
+                fgets(tipo, sizeof(tipo), stdin);
+                tipo[strcspn(tipo, "\n")] = 0;
+                printf("ID do usuario (-1 = todos): ");
+                scanf("%d", &usuario);
+                printf("Ultimos N minutos (0 = todo o periodo): ");
+                scanf("%d", &minutos);
+                getchar();
+                
+                if (tipo[0] != '\0') {
+                    filtro.tipo = tipo_operacao_por_nome(tipo);
+                    if (filtro.tipo < 0) {
+                        printf("Tipo de operacao desconhecido!\n");
+                        break;
+                    }
+                }
+                filtro.usuario_id = usuario;
+                if (minutos > 0) {
+                    filtro.inicio = time(NULL) - (time_t)minutos * 60;
+                }
+                
+                imprimir_diario_operacoes(ARQUIVO_DIARIO_OPERACOES, &filtro);
                 break;
             }
         }
@@ -1,8 +1,18 @@
+#define _POSIX_C_SOURCE 200809L
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stddef.h>
 #include <time.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 #include "pilhas.h"
+#include "crc32c.h"
+#include "diario_operacoes.h"
 
 // ================= IMPLEMENTAO PILHA GENRICA =================
 
@@ -10,6 +20,7 @@ Pilha* criar_pilha() {
     Pilha* pilha = (Pilha*)malloc(sizeof(Pilha));
     if (pilha) {
         pilha->topo = NULL;
+        pilha->base = NULL;
         pilha->tamanho = 0;
     }
     return pilha;
@@ -33,6 +44,13 @@ int empilhar(Pilha* pilha, void* dado) {
     
     novo_no->dado = dado;
     novo_no->abaixo = pilha->topo;
+    novo_no->acima = NULL;
+    
+    if (pilha->topo) {
+        pilha->topo->acima = novo_no;
+    } else {
+        pilha->base = novo_no;
+    }
     pilha->topo = novo_no;
     pilha->tamanho++;
     
@@ -46,6 +64,11 @@ void* desempilhar(Pilha* pilha) {
     void* dado = no_removido->dado;
     
     pilha->topo = no_removido->abaixo;
+    if (pilha->topo) {
+        pilha->topo->acima = NULL;
+    } else {
+        pilha->base = NULL;
+    }
     free(no_removido);
     pilha->tamanho--;
     
@@ -69,34 +92,146 @@ void imprimir_tamanho_pilha(Pilha* pilha, const char* nome_pilha) {
     printf("%s: %d elemento(s)\n", nome_pilha, tamanho_pilha(pilha));
 }
 
+// ================= IMPLEMENTAO CURSOR DA PILHA =================
+// O cursor continua vlido quando novos elementos so empilhados;
+// s no pode estar sobre um elemento que for desempilhado.
+
+CursorPilha cursor_pilha_topo(Pilha* pilha) {
+    CursorPilha cursor;
+    cursor.atual = pilha ? pilha->topo : NULL;
+    cursor.do_topo = true;
+    return cursor;
+}
+
+CursorPilha cursor_pilha_base(Pilha* pilha) {
+    CursorPilha cursor;
+    cursor.atual = pilha ? pilha->base : NULL;
+    cursor.do_topo = false;
+    return cursor;
+}
+
+bool cursor_pilha_valido(const CursorPilha* cursor) {
+    return cursor && cursor->atual != NULL;
+}
+
+void* cursor_pilha_dado(const CursorPilha* cursor) {
+    return cursor_pilha_valido(cursor) ? cursor->atual->dado : NULL;
+}
+
+void cursor_pilha_avancar(CursorPilha* cursor) {
+    if (!cursor_pilha_valido(cursor)) return;
+    cursor->atual = cursor->do_topo ? cursor->atual->abaixo : cursor->atual->acima;
+}
+
 // ================= IMPLEMENTAO PILHA DE VOTOS =================
 
-Pilha* criar_pilha_votos() {
-    return criar_pilha(); // Reutiliza a pilha genrica
+PilhaVotos* criar_pilha_votos() {
+    PilhaVotos* pilha = (PilhaVotos*)malloc(sizeof(PilhaVotos));
+    if (pilha) {
+        iniciar_diretorio_votos(&pilha->blocos);
+        pilha->tamanho = 0;
+        pilha->mapeados = NULL;
+        pilha->num_mapeados = 0;
+        pilha->mapa = NULL;
+        pilha->tamanho_mapa = 0;
+    }
+    return pilha;
+}
+
+void destruir_pilha_votos(PilhaVotos* pilha) {
+    if (!pilha) return;
+    
+    for (int i = 0; i < tamanho_diretorio_votos(&pilha->blocos); i++) {
+        free(pilha->blocos.itens[i]);
+    }
+    liberar_diretorio_votos(&pilha->blocos);
+    if (pilha->mapa) {
+        munmap(pilha->mapa, pilha->tamanho_mapa);
+    }
+    free(pilha);
 }
 
-Voto* criar_voto(int id_eleitor, int numero_candidato, int id_cap, int numero_urna) {
-    Voto* voto = (Voto*)malloc(sizeof(Voto));
-    if (voto) {
-        voto->id_eleitor = id_eleitor;
-        voto->numero_candidato = numero_candidato;
-        voto->id_cap = id_cap;
-        voto->numero_urna = numero_urna;
-        voto->timestamp = time(NULL);
+// Garante que exista bloco para a posio indicada (relativa ao fim da regio mapeada)
+static int reservar_bloco_votos(PilhaVotos* pilha, int indice) {
+    int bloco = indice >> BITS_BLOCO_VOTOS;
+    if (bloco < tamanho_diretorio_votos(&pilha->blocos)) return 1;
+    
+    Voto* novo_bloco = (Voto*)malloc(VOTOS_POR_BLOCO * sizeof(Voto));
+    if (!novo_bloco) return 0;
+    
+    if (!anexar_diretorio_votos(&pilha->blocos, novo_bloco)) {
+        free(novo_bloco);
+        return 0;
     }
+    return 1;
+}
+
+Voto criar_voto(int id_eleitor, int numero_candidato, int id_cap, int numero_urna) {
+    Voto voto;
+    voto.id_eleitor = id_eleitor;
+    voto.numero_candidato = numero_candidato;
+    voto.id_cap = id_cap;
+    voto.numero_urna = numero_urna;
+    voto.timestamp = time(NULL);
     return voto;
 }
 
-void destruir_voto(Voto* voto) {
-    if (voto) free(voto);
+int empilhar_voto(PilhaVotos* pilha, Voto voto) {
+    if (!pilha) return 0;
+    
+    int indice = pilha->tamanho - pilha->num_mapeados;
+    if (!reservar_bloco_votos(pilha, indice)) return 0;
+    
+    pilha->blocos.itens[indice >> BITS_BLOCO_VOTOS][indice & (VOTOS_POR_BLOCO - 1)] = voto;
+    pilha->tamanho++;
+    return 1;
 }
 
-int empilhar_voto(Pilha* pilha, Voto* voto) {
-    return empilhar(pilha, (void*)voto);
+int desempilhar_voto(PilhaVotos* pilha, Voto* voto) {
+    if (!pilha || pilha->tamanho == 0) return 0;
+    
+    if (voto) {
+        *voto = *voto_na_posicao(pilha, pilha->tamanho - 1);
+    }
+    pilha->tamanho--;
+    
+    // Votos retirados da regio mapeada no voltam para ela
+    if (pilha->tamanho < pilha->num_mapeados) {
+        pilha->num_mapeados = pilha->tamanho;
+    }
+    
+    // Liberar o ltimo bloco s quando sobram dois vazios (evita alocar e liberar em ciclo)
+    int num_blocos = tamanho_diretorio_votos(&pilha->blocos);
+    if (num_blocos >= 2 &&
+        pilha->tamanho - pilha->num_mapeados <= (num_blocos - 2) * VOTOS_POR_BLOCO) {
+        Voto* bloco_livre;
+        remover_ultimo_diretorio_votos(&pilha->blocos, &bloco_livre);
+        free(bloco_livre);
+    }
+    
+    return 1;
+}
+
+Voto* topo_pilha_votos(PilhaVotos* pilha) {
+    if (!pilha || pilha->tamanho == 0) return NULL;
+    return voto_na_posicao(pilha, pilha->tamanho - 1);
 }
 
-Voto* desempilhar_voto(Pilha* pilha) {
-    return (Voto*)desempilhar(pilha);
+// Acesso por ndice em ordem de insero (0 = voto mais antigo)
+Voto* voto_na_posicao(PilhaVotos* pilha, int indice) {
+    if (!pilha || indice < 0 || indice >= pilha->tamanho) return NULL;
+    if (indice < pilha->num_mapeados) return &pilha->mapeados[indice];
+    
+    indice -= pilha->num_mapeados;
+    return &pilha->blocos.itens[indice >> BITS_BLOCO_VOTOS][indice & (VOTOS_POR_BLOCO - 1)];
+}
+
+int tamanho_pilha_votos(PilhaVotos* pilha) {
+    return pilha ? pilha->tamanho : 0;
+}
+
+bool pilha_votos_vazia(PilhaVotos* pilha) {
+    return (!pilha || pilha->tamanho == 0);
 }
 
 void imprimir_voto(Voto* voto) {
@@ -117,156 +252,668 @@ void imprimir_voto(Voto* voto) {
     printf("  Data/Hora: %s\n", timestamp_str);
 }
 
-void imprimir_pilha_votos(Pilha* pilha) {
+void imprimir_pilha_votos(PilhaVotos* pilha) {
     if (!pilha) {
         printf("Pilha de votos invalida!\n");
         return;
     }
     
-    printf("=== PILHA DE VOTOS (%d votos) ===\n", tamanho_pilha(pilha));
+    printf("=== PILHA DE VOTOS (%d votos) ===\n", tamanho_pilha_votos(pilha));
     
-    if (pilha_vazia(pilha)) {
+    if (pilha_votos_vazia(pilha)) {
         printf("  [VAZIA]\n");
         return;
     }
     
-    // Para no destruir a pilha, criamos uma temporria
-    Pilha* temp = criar_pilha();
+    // Do topo (mais recente) para a base
     int contador = 1;
-    
-    while (!pilha_vazia(pilha)) {
-        Voto* voto = desempilhar_voto(pilha);
+    for (int i = pilha->tamanho - 1; i >= 0; i--) {
         printf("%d. ", contador++);
-        imprimir_voto(voto);
-        empilhar_voto(temp, voto);
+        imprimir_voto(voto_na_posicao(pilha, i));
     }
+}
+
+// ================= IMPLEMENTAO ARQUIVO DE VOTOS =================
+//
+// Formato (todos os inteiros em little-endian):
+//   [0]  magica "SGVT", verso (u16), tamanho do cabealho (u16)
+//   [8]  votos por bloco, nmero de votos, nmero de blocos (u32)
+//   [20] tamanho do registro (u16), nmero de campos (u16)
+//   [24] descritor de layout: por campo {cdigo, deslocamento, largura, 0}
+//   [60] CRC32C do cabealho e da tabela de CRCs
+//   [64] tabela com o CRC32C de cada bloco (u32), completada at mltiplo de 8
+//   ...  registros de TAMANHO_REGISTRO_VOTO bytes, do mais antigo ao mais recente
+
+#ifndef IOV_MAX
+#define IOV_MAX 1024
+#endif
+
+#define TAMANHO_CABECALHO_VOTOS 64
+#define CAMPOS_REGISTRO_VOTO 5
+#define MAXIMO_VOTOS_POR_BLOCO (1 << 20)  // Limite aceito na leitura
+
+// Cdigos dos campos no descritor de layout
+enum { CAMPO_ID_ELEITOR = 1, CAMPO_CANDIDATO, CAMPO_TIMESTAMP, CAMPO_ID_CAP, CAMPO_URNA };
+
+// {cdigo, deslocamento, largura} de cada campo do registro
+static const unsigned char layout_registro_voto[CAMPOS_REGISTRO_VOTO][3] = {
+    { CAMPO_ID_ELEITOR, 0, 4 },
+    { CAMPO_CANDIDATO, 4, 4 },
+    { CAMPO_TIMESTAMP, 8, 8 },
+    { CAMPO_ID_CAP, 16, 4 },
+    { CAMPO_URNA, 20, 4 }
+};
+
+// Cabealho j decodificado
+typedef struct CabecalhoArquivoVotos {
+    unsigned int votos_por_bloco;
+    unsigned int num_votos;
+    unsigned int num_blocos;
+    unsigned int* crc_blocos;   // CRC32C de cada bloco
+    size_t inicio_registros;    // Deslocamento do primeiro registro
+} CabecalhoArquivoVotos;
+
+static void escrever_u16(unsigned char* p, unsigned int valor) {
+    p[0] = valor & 0xFF;
+    p[1] = (valor >> 8) & 0xFF;
+}
+
+static void escrever_u32(unsigned char* p, unsigned int valor) {
+    for (int i = 0; i < 4; i++) p[i] = (valor >> (8 * i)) & 0xFF;
+}
+
+static void escrever_u64(unsigned char* p, unsigned long long valor) {
+    for (int i = 0; i < 8; i++) p[i] = (valor >> (8 * i)) & 0xFF;
+}
+
+static unsigned int ler_u16(const unsigned char* p) {
+    return p[0] | (unsigned int)p[1] << 8;
+}
+
+static unsigned int ler_u32(const unsigned char* p) {
+    return p[0] | (unsigned int)p[1] << 8 | (unsigned int)p[2] << 16 | (unsigned int)p[3] << 24;
+}
+
+static unsigned long long ler_u64(const unsigned char* p) {
+    unsigned long long valor = 0;
+    for (int i = 7; i >= 0; i--) valor = (valor << 8) | p[i];
+    return valor;
+}
+
+// O Voto em memria j tem o layout do registro? (ento grava/mapeia sem converso)
+static bool layout_voto_nativo() {
+    const unsigned int um = 1;
+    return *(const unsigned char*)&um == 1 &&
+           sizeof(Voto) == TAMANHO_REGISTRO_VOTO && sizeof(time_t) == 8 &&
+           offsetof(Voto, id_eleitor) == 0 && offsetof(Voto, numero_candidato) == 4 &&
+           offsetof(Voto, timestamp) == 8 && offsetof(Voto, id_cap) == 16 &&
+           offsetof(Voto, numero_urna) == 20;
+}
+
+static void codificar_voto(const Voto* voto, unsigned char* registro) {
+    escrever_u32(registro, (unsigned int)voto->id_eleitor);
+    escrever_u32(registro + 4, (unsigned int)voto->numero_candidato);
+    escrever_u64(registro + 8, (unsigned long long)(long long)voto->timestamp);
+    escrever_u32(registro + 16, (unsigned int)voto->id_cap);
+    escrever_u32(registro + 20, (unsigned int)voto->numero_urna);
+}
+
+static void decodificar_voto(const unsigned char* registro, Voto* voto) {
+    voto->id_eleitor = (int)ler_u32(registro);
+    voto->numero_candidato = (int)ler_u32(registro + 4);
+    voto->timestamp = (time_t)(long long)ler_u64(registro + 8);
+    voto->id_cap = (int)ler_u32(registro + 16);
+    voto->numero_urna = (int)ler_u32(registro + 20);
+}
+
+// Votos contguos em memria a partir de indice (at o fim da regio mapeada ou do bloco)
+static Voto* trecho_votos(PilhaVotos* pilha, int indice, int limite, int* quantidade) {
+    int fim_trecho;
+    if (indice < pilha->num_mapeados) {
+        fim_trecho = pilha->num_mapeados;
+    } else {
+        int relativo = indice - pilha->num_mapeados;
+        fim_trecho = indice + VOTOS_POR_BLOCO - (relativo & (VOTOS_POR_BLOCO - 1));
+    }
+    if (fim_trecho > limite) fim_trecho = limite;
+    
+    *quantidade = fim_trecho - indice;
+    return voto_na_posicao(pilha, indice);
+}
+
+// Escreve todos os trechos com writev, retomando aps escritas parciais
+static int escrever_trechos(int fd, struct iovec* trechos, int num_trechos) {
+    while (num_trechos > 0) {
+        int lote = num_trechos < IOV_MAX ? num_trechos : IOV_MAX;
+        ssize_t escritos = writev(fd, trechos, lote);
+        if (escritos < 0) return 0;
+        
+        // Descartar os trechos j escritos por completo
+        while (lote > 0 && (size_t)escritos >= trechos->iov_len) {
+            escritos -= trechos->iov_len;
+            trechos++;
+            num_trechos--;
+            lote--;
+        }
+        if (escritos > 0) {
+            trechos->iov_base = (char*)trechos->iov_base + escritos;
+            trechos->iov_len -= escritos;
+        }
+    }
+    return 1;
+}
+
+static int ler_exato(int fd, void* destino, size_t tamanho) {
+    char* p = (char*)destino;
+    while (tamanho > 0) {
+        ssize_t lidos = read(fd, p, tamanho);
+        if (lidos <= 0) return 0;
+        p += lidos;
+        tamanho -= lidos;
+    }
+    return 1;
+}
+
+static size_t inicio_registros_votos(unsigned int num_blocos) {
+    size_t fim_tabela = TAMANHO_CABECALHO_VOTOS + (size_t)num_blocos * 4;
+    return (fim_tabela + 7) & ~(size_t)7;
+}
+
+// Monta cabealho + tabela de CRCs; crc_blocos j preenchida
+static unsigned char* montar_cabecalho_votos(int num_votos, unsigned int num_blocos,
+                                             const unsigned int* crc_blocos, size_t* tamanho) {
+    *tamanho = inicio_registros_votos(num_blocos);
+    unsigned char* cabecalho = (unsigned char*)calloc(1, *tamanho);
+    if (!cabecalho) return NULL;
     
-    // Restaurar a pilha original
-    while (!pilha_vazia(temp)) {
-        Voto* voto = desempilhar_voto(temp);
-        empilhar_voto(pilha, voto);
+    memcpy(cabecalho, MAGICA_ARQUIVO_VOTOS, 4);
+    escrever_u16(cabecalho + 4, VERSAO_ARQUIVO_VOTOS);
+    escrever_u16(cabecalho + 6, TAMANHO_CABECALHO_VOTOS);
+    escrever_u32(cabecalho + 8, VOTOS_POR_BLOCO);
+    escrever_u32(cabecalho + 12, (unsigned int)num_votos);
+    escrever_u32(cabecalho + 16, num_blocos);
+    escrever_u16(cabecalho + 20, TAMANHO_REGISTRO_VOTO);
+    escrever_u16(cabecalho + 22, CAMPOS_REGISTRO_VOTO);
+    for (int c = 0; c < CAMPOS_REGISTRO_VOTO; c++) {
+        memcpy(cabecalho + 24 + 4 * c, layout_registro_voto[c], 3);
+    }
+    for (unsigned int b = 0; b < num_blocos; b++) {
+        escrever_u32(cabecalho + TAMANHO_CABECALHO_VOTOS + 4 * b, crc_blocos[b]);
     }
     
-    destruir_pilha(temp);
+    unsigned int crc = crc32c(0, cabecalho, 60);
+    crc = crc32c(crc, cabecalho + TAMANHO_CABECALHO_VOTOS, (size_t)num_blocos * 4);
+    escrever_u32(cabecalho + 60, crc);
+    return cabecalho;
 }
 
-int salvar_pilha_votos_arquivo(Pilha* pilha, const char* filename) {
+int salvar_pilha_votos_arquivo(PilhaVotos* pilha, const char* filename) {
     if (!pilha || !filename) return 0;
     
-    FILE* arquivo = fopen(filename, "wb");
-    if (!arquivo) return 0;
+    int num_votos = tamanho_pilha_votos(pilha);
+    unsigned int num_blocos = (num_votos + VOTOS_POR_BLOCO - 1) / VOTOS_POR_BLOCO;
+    bool nativo = layout_voto_nativo();
     
-    // Salvar nmero de votos
-    int num_votos = tamanho_pilha(pilha);
-    fwrite(&num_votos, sizeof(int), 1, arquivo);
+    unsigned int* crc_blocos = (unsigned int*)malloc((num_blocos + 1) * sizeof(unsigned int));
+    unsigned char* registros = nativo ? NULL : (unsigned char*)malloc(VOTOS_POR_BLOCO * TAMANHO_REGISTRO_VOTO);
+    if (!crc_blocos || (!nativo && !registros)) {
+        free(crc_blocos);
+        free(registros);
+        return 0;
+    }
     
-    // Criar pilha temporria para inverter a ordem
-    Pilha* temp = criar_pilha();
+    // Primeira passada: CRC de cada bloco do arquivo
+    for (unsigned int b = 0; b < num_blocos; b++) {
+        int inicio = b * VOTOS_POR_BLOCO;
+        int fim = inicio + VOTOS_POR_BLOCO < num_votos ? inicio + VOTOS_POR_BLOCO : num_votos;
+        unsigned int crc = 0;
+        
+        for (int i = inicio; i < fim; ) {
+            int quantidade;
+            Voto* votos = trecho_votos(pilha, i, fim, &quantidade);
+            if (nativo) {
+                crc = crc32c(crc, votos, (size_t)quantidade * TAMANHO_REGISTRO_VOTO);
+            } else {
+                for (int k = 0; k < quantidade; k++) {
+                    codificar_voto(&votos[k], registros + k * TAMANHO_REGISTRO_VOTO);
+                }
+                crc = crc32c(crc, registros, (size_t)quantidade * TAMANHO_REGISTRO_VOTO);
+            }
+            i += quantidade;
+        }
+        crc_blocos[b] = crc;
+    }
     
-    // Transferir votos para pilha temporria (inverte ordem)
-    while (!pilha_vazia(pilha)) {
-        Voto* voto = desempilhar_voto(pilha);
-        empilhar_voto(temp, voto);
+    size_t tamanho_cabecalho;
+    unsigned char* cabecalho = montar_cabecalho_votos(num_votos, num_blocos, crc_blocos, &tamanho_cabecalho);
+    free(crc_blocos);
+    
+    int fd = cabecalho ? open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644) : -1;
+    if (fd < 0) {
+        free(cabecalho);
+        free(registros);
+        return 0;
     }
     
-    // Salvar votos (do mais antigo ao mais recente)
-    while (!pilha_vazia(temp)) {
-        Voto* voto = desempilhar_voto(temp);
-        fwrite(voto, sizeof(Voto), 1, arquivo);
-        empilhar_voto(pilha, voto); // Restaurar na pilha original
+    int sucesso;
+    if (nativo) {
+        // Cabealho e todos os trechos contguos numa nica chamada writev
+        int max_trechos = 2 + num_votos / VOTOS_POR_BLOCO + 1;
+        struct iovec* trechos = (struct iovec*)malloc(max_trechos * sizeof(struct iovec));
+        sucesso = trechos != NULL;
+        if (sucesso) {
+            int num_trechos = 0;
+            trechos[num_trechos].iov_base = cabecalho;
+            trechos[num_trechos++].iov_len = tamanho_cabecalho;
+            
+            for (int i = 0; i < num_votos; ) {
+                int quantidade;
+                trechos[num_trechos].iov_base = trecho_votos(pilha, i, num_votos, &quantidade);
+                trechos[num_trechos++].iov_len = (size_t)quantidade * TAMANHO_REGISTRO_VOTO;
+                i += quantidade;
+            }
+            sucesso = escrever_trechos(fd, trechos, num_trechos);
+            free(trechos);
+        }
+    } else {
+        // Host com outro layout: converter bloco a bloco
+        struct iovec trecho = { cabecalho, tamanho_cabecalho };
+        sucesso = escrever_trechos(fd, &trecho, 1);
+        
+        for (int i = 0; sucesso && i < num_votos; ) {
+            int quantidade = num_votos - i < VOTOS_POR_BLOCO ? num_votos - i : VOTOS_POR_BLOCO;
+            for (int k = 0; k < quantidade; k++) {
+                codificar_voto(voto_na_posicao(pilha, i + k), registros + k * TAMANHO_REGISTRO_VOTO);
+            }
+            trecho.iov_base = registros;
+            trecho.iov_len = (size_t)quantidade * TAMANHO_REGISTRO_VOTO;
+            sucesso = escrever_trechos(fd, &trecho, 1);
+            i += quantidade;
+        }
     }
     
-    destruir_pilha(temp);
-    fclose(arquivo);
+    free(cabecalho);
+    free(registros);
+    if (close(fd) != 0) sucesso = 0;
+    if (!sucesso) return 0;
     
     printf("Pilha de votos salva em %s (%d votos)\n", filename, num_votos);
     return 1;
 }
 
-Pilha* carregar_pilha_votos_arquivo(const char* filename) {
-    if (!filename) return NULL;
+// L e confere cabealho e tabela de CRCs; retorna NULL ou a descrio do erro
+static const char* ler_cabecalho_votos(int fd, const unsigned char* bruto, CabecalhoArquivoVotos* cabecalho) {
+    cabecalho->crc_blocos = NULL;
     
-    FILE* arquivo = fopen(filename, "rb");
-    if (!arquivo) return NULL;
+    if (memcmp(bruto, MAGICA_ARQUIVO_VOTOS, 4) != 0) return "nao e um arquivo de votos";
+    if (ler_u16(bruto + 4) != VERSAO_ARQUIVO_VOTOS) return "versao do formato nao suportada";
+    if (ler_u16(bruto + 6) != TAMANHO_CABECALHO_VOTOS ||
+        ler_u16(bruto + 20) != TAMANHO_REGISTRO_VOTO ||
+        ler_u16(bruto + 22) != CAMPOS_REGISTRO_VOTO) return "layout de registro desconhecido";
+    for (int c = 0; c < CAMPOS_REGISTRO_VOTO; c++) {
+        if (memcmp(bruto + 24 + 4 * c, layout_registro_voto[c], 3) != 0) {
+            return "layout de registro desconhecido";
+        }
+    }
     
-    // Ler nmero de votos
-    int num_votos;
-    if (fread(&num_votos, sizeof(int), 1, arquivo) != 1) {
-        fclose(arquivo);
-        return NULL;
+    cabecalho->votos_por_bloco = ler_u32(bruto + 8);
+    cabecalho->num_votos = ler_u32(bruto + 12);
+    cabecalho->num_blocos = ler_u32(bruto + 16);
+    if (cabecalho->votos_por_bloco == 0 || cabecalho->votos_por_bloco > MAXIMO_VOTOS_POR_BLOCO ||
+        cabecalho->num_votos > INT_MAX ||
+        cabecalho->num_blocos != (cabecalho->num_votos + cabecalho->votos_por_bloco - 1) / cabecalho->votos_por_bloco) {
+        return "contagens inconsistentes no cabecalho";
     }
     
-    Pilha* pilha = criar_pilha_votos();
+    // Tabela de CRCs dos blocos (coberta pelo CRC do cabealho)
+    size_t bytes_tabela = (size_t)cabecalho->num_blocos * 4;
+    unsigned char* tabela = (unsigned char*)malloc(bytes_tabela + 1);
+    cabecalho->crc_blocos = (unsigned int*)malloc((cabecalho->num_blocos + 1) * sizeof(unsigned int));
+    if (!tabela || !cabecalho->crc_blocos) {
+        free(tabela);
+        return "memoria insuficiente";
+    }
+    if (!ler_exato(fd, tabela, bytes_tabela)) {
+        free(tabela);
+        return "arquivo truncado";
+    }
     
-    // Ler votos e empilhar (o ltimo lido ser o topo)
-    for (int i = 0; i < num_votos; i++) {
-        Voto* voto = (Voto*)malloc(sizeof(Voto));
-        if (fread(voto, sizeof(Voto), 1, arquivo) != 1) {
-            free(voto);
-            destruir_pilha(pilha);
-            fclose(arquivo);
-            return NULL;
-        }
-        empilhar_voto(pilha, voto);
+    unsigned int crc = crc32c(crc32c(0, bruto, 60), tabela, bytes_tabela);
+    for (unsigned int b = 0; b < cabecalho->num_blocos; b++) {
+        cabecalho->crc_blocos[b] = ler_u32(tabela + 4 * b);
     }
+    free(tabela);
+    if (crc != ler_u32(bruto + 60)) return "cabecalho corrompido";
     
-    fclose(arquivo);
-    printf("Pilha de votos carregada de %s (%d votos)\n", filename, num_votos);
-    return pilha;
+    cabecalho->inicio_registros = inicio_registros_votos(cabecalho->num_blocos);
+    return NULL;
 }
 
-// ================= IMPLEMENTAO PILHA DE OPERAES =================
+// Leitura sequencial bloco a bloco, conferindo o CRC antes de entregar os votos
+static const char* percorrer_votos_fd(int fd, void (*callback)(Voto*, void*), void* contexto,
+                                      CabecalhoArquivoVotos* cabecalho) {
+    unsigned char bruto[TAMANHO_CABECALHO_VOTOS];
+    cabecalho->crc_blocos = NULL;
+    if (!ler_exato(fd, bruto, sizeof(bruto))) return "arquivo truncado";
+    
+    const char* erro = ler_cabecalho_votos(fd, bruto, cabecalho);
+    if (erro) return erro;
+    
+    // Pular o preenchimento aps a tabela
+    unsigned char preenchimento[8];
+    size_t lidos = TAMANHO_CABECALHO_VOTOS + (size_t)cabecalho->num_blocos * 4;
+    if (!ler_exato(fd, preenchimento, cabecalho->inicio_registros - lidos)) return "arquivo truncado";
+    
+    size_t bytes_bloco = (size_t)cabecalho->votos_por_bloco * TAMANHO_REGISTRO_VOTO;
+    unsigned char* registros = (unsigned char*)malloc(bytes_bloco);
+    if (!registros) return "memoria insuficiente";
+    
+    unsigned int restantes = cabecalho->num_votos;
+    for (unsigned int b = 0; b < cabecalho->num_blocos; b++) {
+        unsigned int quantidade = restantes < cabecalho->votos_por_bloco ? restantes : cabecalho->votos_por_bloco;
+        size_t bytes = (size_t)quantidade * TAMANHO_REGISTRO_VOTO;
+        
+        if (!ler_exato(fd, registros, bytes)) {
+            erro = "arquivo truncado";
+            break;
+        }
+        if (crc32c(0, registros, bytes) != cabecalho->crc_blocos[b]) {
+            erro = "bloco corrompido (CRC32C divergente)";
+            break;
+        }
+        if (callback) {
+            for (unsigned int k = 0; k < quantidade; k++) {
+                Voto voto;
+                decodificar_voto(registros + (size_t)k * TAMANHO_REGISTRO_VOTO, &voto);
+                callback(&voto, contexto);
+            }
+        }
+        restantes -= quantidade;
+    }
+    
+    // Nada pode sobrar depois do ltimo registro
+    if (!erro && read(fd, preenchimento, 1) != 0) erro = "dados extras no fim do arquivo";
+    
+    free(registros);
+    return erro;
+}
 
-Pilha* criar_pilha_operacoes() {
-    return criar_pilha();
+int percorrer_arquivo_votos(const char* filename, void (*callback)(Voto*, void*), void* contexto) {
+    if (!filename) return -1;
+    
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return -1;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    
+    CabecalhoArquivoVotos cabecalho;
+    const char* erro = percorrer_votos_fd(fd, callback, contexto, &cabecalho);
+    free(cabecalho.crc_blocos);
+    close(fd);
+    
+    return erro ? -1 : (int)cabecalho.num_votos;
 }
 
-Operacao* criar_operacao(const char* tipo, const char* descricao, int usuario_id) {
-    Operacao* operacao = (Operacao*)malloc(sizeof(Operacao));
-    if (operacao) {
-        strncpy(operacao->tipo, tipo, sizeof(operacao->tipo) - 1);
-        strncpy(operacao->descricao, descricao, sizeof(operacao->descricao) - 1);
-        operacao->timestamp = time(NULL);
-        operacao->usuario_id = usuario_id;
+int validar_arquivo_votos(const char* filename) {
+    if (!filename) return 0;
+    
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        printf("Arquivo de votos %s: nao foi possivel abrir\n", filename);
+        return 0;
     }
-    return operacao;
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+    
+    CabecalhoArquivoVotos cabecalho;
+    const char* erro = percorrer_votos_fd(fd, NULL, NULL, &cabecalho);
+    free(cabecalho.crc_blocos);
+    close(fd);
+    
+    if (erro) {
+        printf("Arquivo de votos %s: %s\n", filename, erro);
+        return 0;
+    }
+    printf("Arquivo de votos %s: valido (%u votos, %u blocos)\n", 
+           filename, cabecalho.num_votos, cabecalho.num_blocos);
+    return 1;
 }
 
-void destruir_operacao(Operacao* operacao) {
-    if (operacao) free(operacao);
+static void empilhar_voto_lido(Voto* voto, void* contexto) {
+    empilhar_voto((PilhaVotos*)contexto, *voto);
 }
 
-int registrar_operacao(Pilha* pilha, const char* tipo, const char* descricao, int usuario_id) {
-    Operacao* operacao = criar_operacao(tipo, descricao, usuario_id);
-    if (!operacao) return 0;
+// Mapeia o arquivo e usa os registros no lugar; cada bloco  conferido antes
+static int mapear_votos(PilhaVotos* pilha, int fd, size_t tamanho_arquivo) {
+    unsigned char bruto[TAMANHO_CABECALHO_VOTOS];
+    CabecalhoArquivoVotos cabecalho;
     
-    // Limitar histrico a 1000 operaes
-    if (tamanho_pilha(pilha) > 1000) {
-        // Remover a operao mais antiga (fundo da pilha)
-        // Para fazer isso eficientemente, precisaramos de uma fila
-        // Implementao simplificada: criar nova pilha sem o ltimo
-        Pilha* temp = criar_pilha();
-        
-        // Transferir todas menos a ltima
-        while (tamanho_pilha(pilha) > 1) {
-            Operacao* op = (Operacao*)desempilhar(pilha);
-            empilhar(temp, op);
+    if (!ler_exato(fd, bruto, sizeof(bruto))) return 0;
+    if (ler_cabecalho_votos(fd, bruto, &cabecalho) != NULL ||
+        tamanho_arquivo != cabecalho.inicio_registros + (size_t)cabecalho.num_votos * TAMANHO_REGISTRO_VOTO) {
+        free(cabecalho.crc_blocos);
+        return 0;
+    }
+    if (cabecalho.num_votos == 0) {
+        free(cabecalho.crc_blocos);
+        return 1;
+    }
+    
+    void* mapa = mmap(NULL, tamanho_arquivo, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    if (mapa == MAP_FAILED) {
+        free(cabecalho.crc_blocos);
+        return 0;
+    }
+    
+    const unsigned char* registros = (const unsigned char*)mapa + cabecalho.inicio_registros;
+    size_t bytes_bloco = (size_t)cabecalho.votos_por_bloco * TAMANHO_REGISTRO_VOTO;
+    size_t bytes_total = (size_t)cabecalho.num_votos * TAMANHO_REGISTRO_VOTO;
+    for (unsigned int b = 0; b < cabecalho.num_blocos; b++) {
+        size_t inicio = (size_t)b * bytes_bloco;
+        size_t bytes = bytes_total - inicio < bytes_bloco ? bytes_total - inicio : bytes_bloco;
+        if (crc32c(0, registros + inicio, bytes) != cabecalho.crc_blocos[b]) {
+            munmap(mapa, tamanho_arquivo);
+            free(cabecalho.crc_blocos);
+            return 0;
         }
+    }
+    free(cabecalho.crc_blocos);
+    
+    pilha->mapa = mapa;
+    pilha->tamanho_mapa = tamanho_arquivo;
+    pilha->mapeados = (Voto*)(registros);
+    pilha->num_mapeados = cabecalho.num_votos;
+    pilha->tamanho = cabecalho.num_votos;
+    return 1;
+}
+
+// Formatos antigos (contagem + structs Voto crus do prprio host): copiados para os blocos
+static int ler_votos_formato_bruto(PilhaVotos* pilha, int fd, off_t inicio, int num_votos) {
+    if (lseek(fd, inicio, SEEK_SET) < 0) return 0;
+    
+    while (pilha->tamanho < num_votos) {
+        int quantidade = num_votos - pilha->tamanho;
+        if (quantidade > VOTOS_POR_BLOCO) quantidade = VOTOS_POR_BLOCO;
         
-        // Liberar a operao mais antiga
-        Operacao* antiga = (Operacao*)desempilhar(pilha);
-        destruir_operacao(antiga);
-        
-        // Restaurar as outras
-        while (!pilha_vazia(temp)) {
-            Operacao* op = (Operacao*)desempilhar(temp);
-            empilhar(pilha, op);
+        if (!reservar_bloco_votos(pilha, pilha->tamanho)) return 0;
+        if (!ler_exato(fd, pilha->blocos.itens[pilha->tamanho >> BITS_BLOCO_VOTOS],
+                       (size_t)quantidade * sizeof(Voto))) return 0;
+        pilha->tamanho += quantidade;
+    }
+    return 1;
+}
+
+PilhaVotos* carregar_pilha_votos_arquivo(const char* filename) {
+    if (!filename) return NULL;
+    
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return NULL;
+    
+    char magica[4];
+    struct stat info;
+    if (!ler_exato(fd, magica, sizeof(magica)) || fstat(fd, &info) != 0 || lseek(fd, 0, SEEK_SET) != 0) {
+        close(fd);
+        return NULL;
+    }
+    
+    PilhaVotos* pilha = criar_pilha_votos();
+    if (!pilha) {
+        close(fd);
+        return NULL;
+    }
+    
+    size_t tamanho_arquivo = (size_t)info.st_size;
+    int sucesso;
+    if (memcmp(magica, MAGICA_ARQUIVO_VOTOS, 4) == 0) {
+        if (layout_voto_nativo()) {
+            sucesso = mapear_votos(pilha, fd, tamanho_arquivo);
+        } else {
+            CabecalhoArquivoVotos cabecalho;
+            sucesso = percorrer_votos_fd(fd, empilhar_voto_lido, pilha, &cabecalho) == NULL &&
+                      tamanho_pilha_votos(pilha) == (int)cabecalho.num_votos;
+            free(cabecalho.crc_blocos);
         }
+    } else {
+        // Sem cabealho: contagem (int) seguida de Voto crus, com ou sem preenchimento
+        int num_votos;
+        memcpy(&num_votos, magica, sizeof(int));
+        size_t bytes_votos = (size_t)num_votos * sizeof(Voto);
         
-        destruir_pilha(temp);
+        if (num_votos >= 0 && tamanho_arquivo == 2 * sizeof(int) + bytes_votos) {
+            sucesso = ler_votos_formato_bruto(pilha, fd, 2 * sizeof(int), num_votos);
+        } else if (num_votos >= 0 && tamanho_arquivo == sizeof(int) + bytes_votos) {
+            sucesso = ler_votos_formato_bruto(pilha, fd, sizeof(int), num_votos);
+        } else {
+            sucesso = 0;  // Arquivo truncado ou de outro formato
+        }
+    }
+    
+    close(fd);
+    if (!sucesso) {
+        destruir_pilha_votos(pilha);
+        return NULL;
+    }
+    
+    printf("Pilha de votos carregada de %s (%d votos)\n", filename, tamanho_pilha_votos(pilha));
+    return pilha;
+}
+
+// ================= IMPLEMENTAO HISTRICO DE OPERAES =================
+
+HistoricoOperacoes* criar_historico_operacoes(int capacidade) {
+    if (capacidade <= 0) return NULL;
+    
+    HistoricoOperacoes* historico = (HistoricoOperacoes*)malloc(sizeof(HistoricoOperacoes));
+    if (!historico) return NULL;
+    
+    // Todos os registros so alocados uma nica vez
+    iniciar_fila_operacoes(&historico->registros);
+    if (!reservar_fila_operacoes(&historico->registros, capacidade)) {
+        free(historico);
+        return NULL;
+    }
+    
+    historico->capacidade = capacidade;
+    historico->diario = NULL;
+    return historico;
+}
+
+void destruir_historico_operacoes(HistoricoOperacoes* historico) {
+    if (!historico) return;
+    
+    liberar_fila_operacoes(&historico->registros);
+    free(historico);
+}
+
+int anexar_operacao_historico(HistoricoOperacoes* historico, const Operacao* operacao) {
+    if (!historico || !operacao) return 0;
+    
+    // Com o histrico cheio, a operao mais antiga sai (a fila nunca cresce)
+    if (tamanho_fila_operacoes(&historico->registros) == historico->capacidade) {
+        desenfileirar_fila_operacoes(&historico->registros, NULL);
+    }
+    
+    return enfileirar_fila_operacoes(&historico->registros, *operacao);
+}
+
+int registrar_operacao(HistoricoOperacoes* historico, TipoOperacao tipo, int id_eleitor,
+                       int numero_candidato, int id_cap, int numero_urna, int usuario_id) {
+    if (!historico || tipo < 0 || tipo >= TOTAL_TIPOS_OPERACAO) return 0;
+    
+    // S campos numricos: nenhuma formatao de texto no caminho do voto
+    Operacao operacao;
+    memset(&operacao, 0, sizeof(Operacao));
+    operacao.timestamp = (unsigned int)time(NULL);
+    operacao.usuario_id = usuario_id;
+    operacao.id_eleitor = id_eleitor;
+    operacao.numero_candidato = numero_candidato;
+    operacao.id_cap = id_cap;
+    operacao.numero_urna = numero_urna;
+    operacao.tipo = (unsigned char)tipo;
+    
+    // Persistncia fica com a thread do dirio
+    if (historico->diario) {
+        diario_registrar_operacao(historico->diario, &operacao);
+    }
+    
+    return anexar_operacao_historico(historico, &operacao);
+}
+
+int tamanho_historico(HistoricoOperacoes* historico) {
+    return historico ? tamanho_fila_operacoes(&historico->registros) : 0;
+}
+
+// Retorna a operao na posio indicada, contando da mais recente (0)
+Operacao* operacao_recente(HistoricoOperacoes* historico, int posicao) {
+    if (!historico) return NULL;
+    
+    int total = tamanho_fila_operacoes(&historico->registros);
+    return elemento_fila_operacoes(&historico->registros, total - 1 - posicao);
+}
+
+static const char* nomes_tipos_operacao[TOTAL_TIPOS_OPERACAO] = {
+    "SISTEMA", "ABERTURA", "ENCERRAMENTO", "CHEGADA", "CHAMADA", "VOTO", "FINALIZACAO"
+};
+
+const char* nome_tipo_operacao(int tipo) {
+    if (tipo < 0 || tipo >= TOTAL_TIPOS_OPERACAO) return "DESCONHECIDO";
+    return nomes_tipos_operacao[tipo];
+}
+
+// Retorna o cdigo do tipo ou -1 se o nome no existir
+int tipo_operacao_por_nome(const char* nome) {
+    if (!nome) return -1;
+    
+    for (int i = 0; i < TOTAL_TIPOS_OPERACAO; i++) {
+        if (strcmp(nomes_tipos_operacao[i], nome) == 0) return i;
     }
+    return -1;
+}
+
+// Monta a descrio da operao (s chamada ao exibir ou exportar)
+int formatar_operacao(const Operacao* operacao, char* destino, size_t tamanho) {
+    if (!operacao || !destino || tamanho == 0) return 0;
     
-    return empilhar(pilha, operacao);
+    switch (operacao->tipo) {
+        case OPERACAO_SISTEMA:
+            return snprintf(destino, tamanho, "Sistema de votacao inicializado");
+        case OPERACAO_ABERTURA:
+            return snprintf(destino, tamanho, "Votacao iniciada");
+        case OPERACAO_ENCERRAMENTO:
+            return snprintf(destino, tamanho, "Votacao encerrada");
+        case OPERACAO_CHEGADA:
+            return snprintf(destino, tamanho, "Eleitor %d chegou ao CAP %d",
+                            operacao->id_eleitor, operacao->id_cap);
+        case OPERACAO_CHAMADA:
+            return snprintf(destino, tamanho, "Eleitor %d chamado para votar no CAP %d",
+                            operacao->id_eleitor, operacao->id_cap);
+        case OPERACAO_VOTO:
+            return snprintf(destino, tamanho, "Voto registrado: Eleitor %d -> Candidato %d (Urna %d)",
+                            operacao->id_eleitor, operacao->numero_candidato, operacao->numero_urna);
+        case OPERACAO_FINALIZACAO:
+            return snprintf(destino, tamanho, "Voto finalizado: Eleitor %d na urna %d",
+                            operacao->id_eleitor, operacao->numero_urna);
+        default:
+            return snprintf(destino, tamanho, "Operacao desconhecida (%d)", operacao->tipo);
+    }
 }
 
 void imprimir_operacao(Operacao* operacao) {
@@ -276,108 +923,239 @@ void imprimir_operacao(Operacao* operacao) {
     }
     
     char timestamp_str[50];
-    struct tm* timeinfo = localtime(&operacao->timestamp);
+    time_t instante = (time_t)operacao->timestamp;
+    struct tm* timeinfo = localtime(&instante);
     strftime(timestamp_str, sizeof(timestamp_str), "%Y-%m-%d %H:%M:%S", timeinfo);
     
+    char descricao[200];
+    formatar_operacao(operacao, descricao, sizeof(descricao));
+    
     printf("[%s] %s - %s (Usuario: %d)\n", 
            timestamp_str, 
-           operacao->tipo, 
-           operacao->descricao, 
+           nome_tipo_operacao(operacao->tipo), 
+           descricao, 
            operacao->usuario_id);
 }
 
-void imprimir_historico_operacoes(Pilha* pilha, int limite) {
-    if (!pilha) {
-        printf("Pilha de operacoes invalida!\n");
+void imprimir_historico_operacoes(HistoricoOperacoes* historico, int limite) {
+    if (!historico) {
+        printf("Historico de operacoes invalido!\n");
         return;
     }
     
-    int total = tamanho_pilha(pilha);
+    int total = tamanho_historico(historico);
     if (limite <= 0 || limite > total) {
         limite = total;
     }
     
     printf("=== HISTORICO DE OPERACOES (%d/%d mostradas) ===\n", limite, total);
     
-    if (pilha_vazia(pilha)) {
+    if (total == 0) {
         printf("  [VAZIO]\n");
         return;
     }
     
-    // Para no destruir a pilha, criamos uma temporria
-    Pilha* temp = criar_pilha();
-    int contador = 0;
+    // Da mais recente para a mais antiga
+    for (int i = 0; i < limite; i++) {
+        imprimir_operacao(operacao_recente(historico, i));
+    }
+}
+
+void limpar_historico(HistoricoOperacoes* historico) {
+    if (!historico) return;
     
-    while (!pilha_vazia(pilha) && contador < limite) {
-        Operacao* operacao = (Operacao*)desempilhar(pilha);
-        imprimir_operacao(operacao);
-        empilhar(temp, operacao);
-        contador++;
+    limpar_fila_operacoes(&historico->registros);
+}
+
+// ================= IMPLEMENTAO REGISTRO DE ELEITORES ATENDIDOS =================
+
+RegistroAtendidos* criar_registro_atendidos() {
+    RegistroAtendidos* registro = (RegistroAtendidos*)malloc(sizeof(RegistroAtendidos));
+    if (registro) {
+        iniciar_atendidos_caps(&registro->por_cap);
+        registro->indice_caps = NULL;
+        registro->capacidade_indice = 0;
+        registro->total = 0;
     }
+    return registro;
+}
+
+void destruir_registro_atendidos(RegistroAtendidos* registro) {
+    if (!registro) return;
     
-    // Restaurar a pilha original
-    while (!pilha_vazia(temp)) {
-        Operacao* operacao = (Operacao*)desempilhar(temp);
-        empilhar(pilha, operacao);
+    for (int c = 0; c < tamanho_atendidos_caps(&registro->por_cap); c++) {
+        AtendidosCAP* atendidos = registro->por_cap.itens[c];
+        if (!atendidos) continue;
+        
+        for (int b = 0; b < tamanho_diretorio_ids(&atendidos->log); b++) {
+            free(atendidos->log.itens[b]);
+        }
+        liberar_diretorio_ids(&atendidos->log);
+        liberar_bits_atendidos(&atendidos->bitmap);
+        free(atendidos);
+    }
+    liberar_atendidos_caps(&registro->por_cap);
+    free(registro->indice_caps);
+    free(registro);
+}
+
+// Primeira casa da tabela para o ID (disperso multiplicativa)
+static inline int casa_indice_caps(int id_cap, int capacidade) {
+    return (int)(((unsigned int)id_cap * 2654435761u) & (unsigned int)(capacidade - 1));
+}
+
+// Casa do ID na tabela: a que guarda o CAP ou a livre onde ele entraria
+static int buscar_casa_indice_caps(RegistroAtendidos* registro, int id_cap) {
+    int mascara = registro->capacidade_indice - 1;
+    int casa = casa_indice_caps(id_cap, registro->capacidade_indice);
+    while (registro->indice_caps[casa] != 0 &&
+           registro->por_cap.itens[registro->indice_caps[casa] - 1]->id_cap != id_cap) {
+        casa = (casa + 1) & mascara;
     }
+    return casa;
+}
+
+// Dobra a tabela e redistribui os CAPs j registrados
+static int crescer_indice_caps(RegistroAtendidos* registro) {
+    int capacidade = registro->capacidade_indice ? registro->capacidade_indice * 2 : 16;
+    int* tabela = (int*)calloc(capacidade, sizeof(int));
+    if (!tabela) return 0;
     
-    destruir_pilha(temp);
+    free(registro->indice_caps);
+    registro->indice_caps = tabela;
+    registro->capacidade_indice = capacidade;
+    for (int i = 0; i < tamanho_atendidos_caps(&registro->por_cap); i++) {
+        int casa = buscar_casa_indice_caps(registro, registro->por_cap.itens[i]->id_cap);
+        tabela[casa] = i + 1;
+    }
+    return 1;
 }
 
-void limpar_historico(Pilha* pilha) {
-    if (!pilha) return;
+// Registro do CAP (criado sob demanda quando criar = true). O ID do CAP  o
+// que o operador digitou, ento vai por uma tabela de disperso: a memria
+// acompanha o nmero de CAPs com atendimento, no o maior ID
+static AtendidosCAP* atendidos_do_cap(RegistroAtendidos* registro, int id_cap, bool criar) {
+    if (!registro) return NULL;
     
-    while (!pilha_vazia(pilha)) {
-        Operacao* operacao = (Operacao*)desempilhar(pilha);
-        destruir_operacao(operacao);
+    if (registro->capacidade_indice > 0) {
+        int casa = buscar_casa_indice_caps(registro, id_cap);
+        if (registro->indice_caps[casa] != 0) {
+            return registro->por_cap.itens[registro->indice_caps[casa] - 1];
+        }
     }
+    if (!criar) return NULL;
+    
+    // Tabela no mximo meio cheia, para as sondagens ficarem curtas
+    if (2 * (tamanho_atendidos_caps(&registro->por_cap) + 1) > registro->capacidade_indice &&
+        !crescer_indice_caps(registro)) {
+        return NULL;
+    }
+    
+    AtendidosCAP* atendidos = (AtendidosCAP*)malloc(sizeof(AtendidosCAP));
+    if (!atendidos) return NULL;
+    atendidos->id_cap = id_cap;
+    iniciar_bits_atendidos(&atendidos->bitmap);
+    iniciar_diretorio_ids(&atendidos->log);
+    atendidos->total = 0;
+    if (!anexar_atendidos_caps(&registro->por_cap, atendidos)) {
+        free(atendidos);
+        return NULL;
+    }
+    
+    int casa = buscar_casa_indice_caps(registro, id_cap);
+    registro->indice_caps[casa] = tamanho_atendidos_caps(&registro->por_cap);
+    return atendidos;
 }
 
-// ================= IMPLEMENTAO PILHA DE ELEITORES ATENDIDOS =================
+// ID na posio indicada do log (0 = primeiro atendido)
+static int id_atendido(AtendidosCAP* atendidos, int indice) {
+    return atendidos->log.itens[indice >> BITS_BLOCO_ATENDIDOS][indice & (IDS_POR_BLOCO_ATENDIDOS - 1)];
+}
 
-Pilha* criar_pilha_eleitores_atendidos() {
-    return criar_pilha();
+static bool bit_atendido(AtendidosCAP* atendidos, int id_eleitor) {
+    int palavra = id_eleitor >> 6;
+    if (palavra >= tamanho_bits_atendidos(&atendidos->bitmap)) return false;
+    return (atendidos->bitmap.itens[palavra] >> (id_eleitor & 63)) & 1;
 }
 
-int empilhar_eleitor_atendido(Pilha* pilha, Eleitor* eleitor) {
-    return empilhar(pilha, (void*)eleitor);
+// Retorna 0 se o eleitor j tinha sido atendido neste CAP ou em caso de erro
+int registrar_eleitor_atendido(RegistroAtendidos* registro, int id_cap, int id_eleitor) {
+    if (id_eleitor < 0) return 0;
+    
+    AtendidosCAP* atendidos = atendidos_do_cap(registro, id_cap, true);
+    if (!atendidos || bit_atendido(atendidos, id_eleitor)) return 0;
+    
+    // Novo bloco do log quando o atual enche
+    int posicao = atendidos->total & (IDS_POR_BLOCO_ATENDIDOS - 1);
+    if (posicao == 0) {
+        int* bloco = (int*)malloc(IDS_POR_BLOCO_ATENDIDOS * sizeof(int));
+        if (!bloco) return 0;
+        if (!anexar_diretorio_ids(&atendidos->log, bloco)) {
+            free(bloco);
+            return 0;
+        }
+    }
+    
+    // Bitmap cresce at cobrir o maior ID visto
+    int palavra = id_eleitor >> 6;
+    while (tamanho_bits_atendidos(&atendidos->bitmap) <= palavra) {
+        if (!anexar_bits_atendidos(&atendidos->bitmap, 0)) return 0;
+    }
+    
+    atendidos->bitmap.itens[palavra] |= 1ULL << (id_eleitor & 63);
+    atendidos->log.itens[atendidos->total >> BITS_BLOCO_ATENDIDOS][posicao] = id_eleitor;
+    atendidos->total++;
+    registro->total++;
+    return 1;
 }
 
-Eleitor* desempilhar_eleitor_atendido(Pilha* pilha) {
-    return (Eleitor*)desempilhar(pilha);
+bool eleitor_foi_atendido(RegistroAtendidos* registro, int id_cap, int id_eleitor) {
+    if (id_eleitor < 0) return false;
+    
+    AtendidosCAP* atendidos = atendidos_do_cap(registro, id_cap, false);
+    return atendidos && bit_atendido(atendidos, id_eleitor);
 }
 
-void imprimir_eleitores_atendidos(Pilha* pilha) {
-    if (!pilha) {
-        printf("Pilha de eleitores atendidos invalida!\n");
+int total_atendidos_cap(RegistroAtendidos* registro, int id_cap) {
+    AtendidosCAP* atendidos = atendidos_do_cap(registro, id_cap, false);
+    return atendidos ? atendidos->total : 0;
+}
+
+int total_atendidos(RegistroAtendidos* registro) {
+    return registro ? registro->total : 0;
+}
+
+// Copia at k IDs, do ltimo atendido para trs; retorna quantos copiou
+int ultimos_atendidos_cap(RegistroAtendidos* registro, int id_cap, int k, int* destino) {
+    AtendidosCAP* atendidos = atendidos_do_cap(registro, id_cap, false);
+    if (!atendidos || !destino || k <= 0) return 0;
+    
+    if (k > atendidos->total) k = atendidos->total;
+    for (int i = 0; i < k; i++) {
+        destino[i] = id_atendido(atendidos, atendidos->total - 1 - i);
+    }
+    return k;
+}
+
+void imprimir_eleitores_atendidos(RegistroAtendidos* registro, int id_cap, int limite) {
+    if (!registro) {
+        printf("Registro de eleitores atendidos invalido!\n");
         return;
     }
     
-    printf("=== ULTIMOS ELEITORES ATENDIDOS (%d) ===\n", tamanho_pilha(pilha));
+    AtendidosCAP* atendidos = atendidos_do_cap(registro, id_cap, false);
+    int total = atendidos ? atendidos->total : 0;
+    if (limite <= 0 || limite > total) limite = total;
+    
+    printf("=== ULTIMOS ELEITORES ATENDIDOS - CAP %d (%d/%d) ===\n", id_cap, limite, total);
     
-    if (pilha_vazia(pilha)) {
+    if (total == 0) {
         printf("  [VAZIA]\n");
         return;
     }
     
-    Pilha* temp = criar_pilha();
-    int contador = 1;
-    
-    while (!pilha_vazia(pilha)) {
-        Eleitor* eleitor = desempilhar_eleitor_atendido(pilha);
-        printf("%d. %s (ID: %d, CAP: %d)\n", 
-               contador++, 
-               eleitor->nome, 
-               eleitor->id, 
-               eleitor->id_cap);
-        empilhar_eleitor_atendido(temp, eleitor);
-    }
-    
-    // Restaurar a pilha original
-    while (!pilha_vazia(temp)) {
-        Eleitor* eleitor = desempilhar_eleitor_atendido(temp);
-        empilhar_eleitor_atendido(pilha, eleitor);
+    // Do ltimo atendido para trs, direto do log
+    for (int i = 0; i < limite; i++) {
+        printf("%d. Eleitor ID: %d\n", i + 1, id_atendido(atendidos, total - 1 - i));
     }
-    
-    destruir_pilha(temp);
 }
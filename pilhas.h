@@ -19,38 +19,70 @@ bool pilha_vazia(Pilha* pilha);
 int tamanho_pilha(Pilha* pilha);
 void imprimir_tamanho_pilha(Pilha* pilha, const char* nome_pilha);
 
+// Cursor somente leitura (topo -> base ou base -> topo)
+CursorPilha cursor_pilha_topo(Pilha* pilha);
+CursorPilha cursor_pilha_base(Pilha* pilha);
+bool cursor_pilha_valido(const CursorPilha* cursor);
+void* cursor_pilha_dado(const CursorPilha* cursor);
+void cursor_pilha_avancar(CursorPilha* cursor);
+
 // ================= PILHA DE VOTOS =================
 
-// Criao especializada
-Pilha* criar_pilha_votos();
+// Criao especializada (votos guardados por valor em blocos contguos)
+PilhaVotos* criar_pilha_votos();
+void destruir_pilha_votos(PilhaVotos* pilha);
 
 // Operaes com votos
-int empilhar_voto(Pilha* pilha, Voto* voto);
-Voto* desempilhar_voto(Pilha* pilha);
-Voto* criar_voto(int id_eleitor, int numero_candidato, int id_cap, int numero_urna);
-void destruir_voto(Voto* voto);
+Voto criar_voto(int id_eleitor, int numero_candidato, int id_cap, int numero_urna);
+int empilhar_voto(PilhaVotos* pilha, Voto voto);
+int desempilhar_voto(PilhaVotos* pilha, Voto* voto);
+Voto* topo_pilha_votos(PilhaVotos* pilha);
+Voto* voto_na_posicao(PilhaVotos* pilha, int indice);
+int tamanho_pilha_votos(PilhaVotos* pilha);
+bool pilha_votos_vazia(PilhaVotos* pilha);
 void imprimir_voto(Voto* voto);
-void imprimir_pilha_votos(Pilha* pilha);
+void imprimir_pilha_votos(PilhaVotos* pilha);
+
+// Arquivo de votos: formato little-endian com verso, layout e CRC32C por bloco
+#define MAGICA_ARQUIVO_VOTOS "SGVT"
+#define VERSAO_ARQUIVO_VOTOS 1
+#define TAMANHO_REGISTRO_VOTO 24    // Bytes por voto no arquivo
 
 // Backup e restaurao
-int salvar_pilha_votos_arquivo(Pilha* pilha, const char* filename);
-Pilha* carregar_pilha_votos_arquivo(const char* filename);
+int salvar_pilha_votos_arquivo(PilhaVotos* pilha, const char* filename);
+PilhaVotos* carregar_pilha_votos_arquivo(const char* filename);
+
+// Leitura sequencial com verificao (no carrega o arquivo inteiro)
+int percorrer_arquivo_votos(const char* filename, void (*callback)(Voto*, void*), void* contexto);
+int validar_arquivo_votos(const char* filename);
+
+// ================= HISTRICO DE OPERAES (BUFFER CIRCULAR) =================
 
-// ================= PILHA DE OPERAES (HISTRICO) =================
+#define CAPACIDADE_HISTORICO 1000   // Operaes mantidas em memria
 
-Pilha* criar_pilha_operacoes();
-Operacao* criar_operacao(const char* tipo, const char* descricao, int usuario_id);
-void destruir_operacao(Operacao* operacao);
-int registrar_operacao(Pilha* pilha, const char* tipo, const char* descricao, int usuario_id);
+HistoricoOperacoes* criar_historico_operacoes(int capacidade);
+void destruir_historico_operacoes(HistoricoOperacoes* historico);
+int registrar_operacao(HistoricoOperacoes* historico, TipoOperacao tipo, int id_eleitor,
+                       int numero_candidato, int id_cap, int numero_urna, int usuario_id);
+int anexar_operacao_historico(HistoricoOperacoes* historico, const Operacao* operacao);
+int tamanho_historico(HistoricoOperacoes* historico);
+Operacao* operacao_recente(HistoricoOperacoes* historico, int posicao);
+const char* nome_tipo_operacao(int tipo);
+int tipo_operacao_por_nome(const char* nome);
+int formatar_operacao(const Operacao* operacao, char* destino, size_t tamanho);
 void imprimir_operacao(Operacao* operacao);
-void imprimir_historico_operacoes(Pilha* pilha, int limite);
-void limpar_historico(Pilha* pilha);
+void imprimir_historico_operacoes(HistoricoOperacoes* historico, int limite);
+void limpar_historico(HistoricoOperacoes* historico);
 
-// ================= PILHA DE ELEITORES (PARA CONTROLE) =================
+// ================= REGISTRO DE ELEITORES ATENDIDOS (POR CAP) =================
 
-Pilha* criar_pilha_eleitores_atendidos();
-int empilhar_eleitor_atendido(Pilha* pilha, Eleitor* eleitor);
-Eleitor* desempilhar_eleitor_atendido(Pilha* pilha);
-void imprimir_eleitores_atendidos(Pilha* pilha);
+RegistroAtendidos* criar_registro_atendidos();
+void destruir_registro_atendidos(RegistroAtendidos* registro);
+int registrar_eleitor_atendido(RegistroAtendidos* registro, int id_cap, int id_eleitor);
+bool eleitor_foi_atendido(RegistroAtendidos* registro, int id_cap, int id_eleitor);
+int total_atendidos_cap(RegistroAtendidos* registro, int id_cap);
+int total_atendidos(RegistroAtendidos* registro);
+int ultimos_atendidos_cap(RegistroAtendidos* registro, int id_cap, int k, int* destino);
+void imprimir_eleitores_atendidos(RegistroAtendidos* registro, int id_cap, int limite);
 
 #endif
@@ -0,0 +1,497 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "tabela_resultados.h"
+#include "escritor_saida.h"
+
+#define CAPACIDADE_INICIAL_TABELA 64
+#define LINHAS_POR_BLOCO_VISTA 256
+
+static int garantir_blocos_vistas(TabelaResultados* tabela, int linhas);
+
+// ================= IMPLEMENTAO POOL DE LINHAS =================
+
+static int crescer_linhas(TabelaResultados* tabela) {
+    int nova = tabela->capacidade_linhas ? tabela->capacidade_linhas * 2 : CAPACIDADE_INICIAL_TABELA;
+    
+    DadosResultado* dados = (DadosResultado*)realloc(tabela->dados, nova * sizeof(DadosResultado));
+    if (!dados) return 0;
+    tabela->dados = dados;
+    
+    char (*nomes)[MAX_NOME] = (char (*)[MAX_NOME])realloc(tabela->nomes, nova * sizeof(*nomes));
+    if (!nomes) return 0;
+    tabela->nomes = nomes;
+    
+    unsigned char* ocupada = (unsigned char*)realloc(tabela->ocupada, nova);
+    if (!ocupada) return 0;
+    tabela->ocupada = ocupada;
+    
+    int* livres = (int*)realloc(tabela->livres, nova * sizeof(int));
+    if (!livres) return 0;
+    tabela->livres = livres;
+    
+    if (tabela->vistas_ativas && !garantir_blocos_vistas(tabela, nova)) return 0;
+    
+    tabela->capacidade_linhas = nova;
+    return 1;
+}
+
+static int alocar_linha(TabelaResultados* tabela) {
+    if (tabela->num_livres > 0) return tabela->livres[--tabela->num_livres];
+    if (tabela->linhas_usadas == tabela->capacidade_linhas && !crescer_linhas(tabela)) return -1;
+    return tabela->linhas_usadas++;
+}
+
+static void liberar_linha(TabelaResultados* tabela, int linha) {
+    tabela->ocupada[linha] = 0;
+    tabela->livres[tabela->num_livres++] = linha;
+}
+
+// Uma chave  vlida se a linha ainda est ocupada pelo mesmo ID
+static int chave_valida(TabelaResultados* tabela, ParChaveResultado chave) {
+    return chave.linha >= 0 && chave.linha < tabela->linhas_usadas &&
+           tabela->ocupada[chave.linha] && tabela->dados[chave.linha].id == chave.id;
+}
+
+static void montar_resultado(TabelaResultados* tabela, int linha, ResultadoVotacao* saida) {
+    DadosResultado* d = &tabela->dados[linha];
+    
+    saida->id = d->id;
+    memcpy(saida->nome, tabela->nomes[linha], MAX_NOME);
+    saida->tipo = d->tipo;
+    saida->votos = d->votos;
+    saida->votos_validos = d->votos_validos;
+    saida->votos_brancos = d->votos_brancos;
+    saida->votos_nulos = d->votos_nulos;
+    saida->percentual = d->percentual;
+}
+
+// ================= IMPLEMENTAO VISTAS =================
+
+// Blocos novos entram no fim do vetor de blocos; os j entregues no se
+// movem, ento os ponteiros devolvidos continuam valendo
+static int garantir_blocos_vistas(TabelaResultados* tabela, int linhas) {
+    int necessarios = (linhas + LINHAS_POR_BLOCO_VISTA - 1) / LINHAS_POR_BLOCO_VISTA;
+    if (necessarios <= tabela->num_blocos_vistas) return 1;
+    
+    ResultadoVotacao** blocos = (ResultadoVotacao**)realloc(tabela->blocos_vistas,
+                                                           necessarios * sizeof(ResultadoVotacao*));
+    if (!blocos) return 0;
+    tabela->blocos_vistas = blocos;
+    
+    while (tabela->num_blocos_vistas < necessarios) {
+        ResultadoVotacao* bloco = (ResultadoVotacao*)malloc(LINHAS_POR_BLOCO_VISTA * sizeof(ResultadoVotacao));
+        if (!bloco) return 0;
+        tabela->blocos_vistas[tabela->num_blocos_vistas++] = bloco;
+    }
+    return 1;
+}
+
+static ResultadoVotacao* vista_linha(TabelaResultados* tabela, int linha) {
+    return &tabela->blocos_vistas[linha / LINHAS_POR_BLOCO_VISTA][linha % LINHAS_POR_BLOCO_VISTA];
+}
+
+// Monta a vista de todas as linhas ocupadas; da em diante cada mudana
+// de linha tambm atualiza a vista
+static int ativar_vistas(TabelaResultados* tabela) {
+    if (tabela->vistas_ativas) return 1;
+    if (!garantir_blocos_vistas(tabela, tabela->capacidade_linhas)) return 0;
+    
+    for (int linha = 0; linha < tabela->linhas_usadas; linha++) {
+        if (tabela->ocupada[linha]) montar_resultado(tabela, linha, vista_linha(tabela, linha));
+    }
+    tabela->vistas_ativas = 1;
+    return 1;
+}
+
+static void sincronizar_votos_vista(TabelaResultados* tabela, int linha) {
+    if (tabela->vistas_ativas) vista_linha(tabela, linha)->votos = tabela->dados[linha].votos;
+}
+
+// ================= IMPLEMENTAO LAYOUT EYTZINGER =================
+
+// Intercala a e b (ambos ordenados por ID) em destino; no empate a vem
+// antes, o que mantm a ordem de chegada
+static void intercalar_chaves(const ParChaveResultado* a, int na, const ParChaveResultado* b, int nb,
+                              ParChaveResultado* destino) {
+    int i = 0, j = 0, k = 0;
+    while (i < na && j < nb) {
+        destino[k++] = (b[j].id < a[i].id) ? b[j++] : a[i++];
+    }
+    while (i < na) destino[k++] = a[i++];
+    while (j < nb) destino[k++] = b[j++];
+}
+
+// Ordenao estvel (intercalao de baixo para cima)
+static int ordenar_chaves(ParChaveResultado* chaves, int n) {
+    if (n < 2) return 1;
+    
+    ParChaveResultado* auxiliar = (ParChaveResultado*)malloc(n * sizeof(ParChaveResultado));
+    if (!auxiliar) return 0;
+    
+    ParChaveResultado* origem = chaves;
+    ParChaveResultado* destino = auxiliar;
+    for (int largura = 1; largura < n; largura *= 2) {
+        for (int inicio = 0; inicio < n; inicio += 2 * largura) {
+            int meio = inicio + largura < n ? inicio + largura : n;
+            int fim = inicio + 2 * largura < n ? inicio + 2 * largura : n;
+            intercalar_chaves(origem + inicio, meio - inicio, origem + meio, fim - meio, destino + inicio);
+        }
+        ParChaveResultado* temp = origem;
+        origem = destino;
+        destino = temp;
+    }
+    
+    if (origem != chaves) memcpy(chaves, origem, n * sizeof(ParChaveResultado));
+    free(auxiliar);
+    return 1;
+}
+
+// Percurso em ordem da rvore implcita (filhos de k em 2k e 2k+1)
+static int preencher_eytzinger(TabelaResultados* tabela, int i, int k) {
+    if (k > tabela->num_eytzinger) return i;
+    
+    i = preencher_eytzinger(tabela, i, 2 * k);
+    tabela->chaves_eytzinger[k] = tabela->ordenadas[i].id;
+    tabela->linhas_eytzinger[k] = tabela->ordenadas[i].linha;
+    i++;
+    return preencher_eytzinger(tabela, i, 2 * k + 1);
+}
+
+// Junta as inseres pendentes s chaves ordenadas, descarta chaves de
+// linhas removidas, funde IDs repetidos (o primeiro a chegar fica com a
+// linha e recebe os votos dos outros) e refaz o layout Eytzinger
+static int refazer_layout(TabelaResultados* tabela) {
+    if (!ordenar_chaves(tabela->novas, tabela->num_novas)) return 0;
+    
+    int total = tabela->num_ordenadas + tabela->num_novas;
+    ParChaveResultado* mescladas = (ParChaveResultado*)malloc((total > 0 ? total : 1) * sizeof(ParChaveResultado));
+    int* chaves = (int*)malloc((total + 1) * sizeof(int));
+    int* linhas = (int*)malloc((total + 1) * sizeof(int));
+    if (!mescladas || !chaves || !linhas) {
+        free(mescladas);
+        free(chaves);
+        free(linhas);
+        return 0;
+    }
+    
+    intercalar_chaves(tabela->ordenadas, tabela->num_ordenadas, tabela->novas, tabela->num_novas, mescladas);
+    
+    int n = 0;
+    for (int i = 0; i < total; i++) {
+        ParChaveResultado chave = mescladas[i];
+        if (!chave_valida(tabela, chave)) continue;
+        
+        if (n > 0 && mescladas[n - 1].id == chave.id) {
+            // Mesma linha vista duas vezes (chave antiga reaproveitada): ignora
+            if (mescladas[n - 1].linha == chave.linha) continue;
+            
+            DadosResultado* destino = &tabela->dados[mescladas[n - 1].linha];
+            destino->votos += tabela->dados[chave.linha].votos;
+            sincronizar_votos_vista(tabela, mescladas[n - 1].linha);
+            liberar_linha(tabela, chave.linha);
+            tabela->quantidade--;
+            continue;
+        }
+        mescladas[n++] = chave;
+    }
+    
+    free(tabela->ordenadas);
+    free(tabela->chaves_eytzinger);
+    free(tabela->linhas_eytzinger);
+    
+    tabela->ordenadas = mescladas;
+    tabela->num_ordenadas = n;
+    tabela->num_novas = 0;
+    tabela->chaves_eytzinger = chaves;
+    tabela->linhas_eytzinger = linhas;
+    tabela->num_eytzinger = n;
+    preencher_eytzinger(tabela, 0, 1);
+    
+    tabela->layout_pendente = 0;
+    tabela->removidas = 0;
+    return 1;
+}
+
+// Posio de id no layout atual (sem refazer), ou 0. A descida no tem
+// desvios dependentes da comparao, e os 16 descendentes quatro nveis
+// abaixo ocupam uma nica linha de cache, que  pedida antes de precisar dela.
+static int buscar_posicao_layout(TabelaResultados* tabela, int id) {
+    const int* chaves = tabela->chaves_eytzinger;
+    int n = tabela->num_eytzinger;
+    int k = 1;
+    
+    while (k <= n) {
+#if defined(__GNUC__)
+        __builtin_prefetch(chaves + 16 * k);
+#endif
+        k = 2 * k + (chaves[k] < id);
+    }
+    
+    // Volta as descidas  direita do fim: k passa a ser o primeiro >= id
+    while (k & 1) k >>= 1;
+    k >>= 1;
+    
+    return (k != 0 && chaves[k] == id) ? k : 0;
+}
+
+// A remoo marca a linha da chave no layout com -1, ento a linha achada
+// vale sem consultar o pool (que fica em outra linha de cache)
+static int buscar_linha_layout(TabelaResultados* tabela, int id) {
+    int k = buscar_posicao_layout(tabela, id);
+    return k ? tabela->linhas_eytzinger[k] : -1;
+}
+
+static int buscar_linha(TabelaResultados* tabela, int id) {
+    if (tabela->layout_pendente && !refazer_layout(tabela)) return -1;
+    return buscar_linha_layout(tabela, id);
+}
+
+// ================= IMPLEMENTAO TABELA DE RESULTADOS =================
+
+TabelaResultados* criar_tabela_resultados(TipoNoArvore tipo) {
+    TabelaResultados* tabela = (TabelaResultados*)calloc(1, sizeof(TabelaResultados));
+    if (tabela) {
+        tabela->tipo_tabela = tipo;
+    }
+    return tabela;
+}
+
+void destruir_tabela_resultados(TabelaResultados* tabela) {
+    if (!tabela) return;
+    
+    free(tabela->dados);
+    free(tabela->nomes);
+    free(tabela->ocupada);
+    free(tabela->livres);
+    free(tabela->ordenadas);
+    free(tabela->novas);
+    free(tabela->chaves_eytzinger);
+    free(tabela->linhas_eytzinger);
+    for (int i = 0; i < tabela->num_blocos_vistas; i++) free(tabela->blocos_vistas[i]);
+    free(tabela->blocos_vistas);
+    free(tabela);
+}
+
+int inserir_resultado_tabela(TabelaResultados* tabela, ResultadoVotacao resultado) {
+    if (!tabela) return 0;
+    
+    // ID j presente no layout: soma os votos, como a rvore faz
+    int existente = buscar_linha_layout(tabela, resultado.id);
+    if (existente >= 0) {
+        tabela->dados[existente].votos += resultado.votos;
+        sincronizar_votos_vista(tabela, existente);
+        tabela->total_votos += resultado.votos;
+        tabela->percentuais_pendentes = 1;
+        return 1;
+    }
+    
+    if (tabela->num_novas == tabela->capacidade_novas) {
+        int nova = tabela->capacidade_novas ? tabela->capacidade_novas * 2 : CAPACIDADE_INICIAL_TABELA;
+        ParChaveResultado* novas = (ParChaveResultado*)realloc(tabela->novas, nova * sizeof(ParChaveResultado));
+        if (!novas) return 0;
+        tabela->novas = novas;
+        tabela->capacidade_novas = nova;
+    }
+    
+    int linha = alocar_linha(tabela);
+    if (linha < 0) return 0;
+    
+    DadosResultado* d = &tabela->dados[linha];
+    d->id = resultado.id;
+    d->tipo = resultado.tipo;
+    d->votos = resultado.votos;
+    d->votos_validos = resultado.votos_validos;
+    d->votos_brancos = resultado.votos_brancos;
+    d->votos_nulos = resultado.votos_nulos;
+    d->percentual = resultado.percentual;
+    memcpy(tabela->nomes[linha], resultado.nome, MAX_NOME);
+    tabela->nomes[linha][MAX_NOME - 1] = '\0';
+    tabela->ocupada[linha] = 1;
+    if (tabela->vistas_ativas) montar_resultado(tabela, linha, vista_linha(tabela, linha));
+    
+    ParChaveResultado chave = { resultado.id, linha };
+    tabela->novas[tabela->num_novas++] = chave;
+    
+    // IDs repetidos entre as pendentes so fundidos ao refazer o layout
+    tabela->quantidade++;
+    tabela->total_votos += resultado.votos;
+    tabela->layout_pendente = 1;
+    tabela->percentuais_pendentes = 1;
+    return 1;
+}
+
+int remover_resultado_tabela(TabelaResultados* tabela, int id) {
+    if (!tabela) return 0;
+    
+    if (tabela->layout_pendente && !refazer_layout(tabela)) return 0;
+    int k = buscar_posicao_layout(tabela, id);
+    int linha = k ? tabela->linhas_eytzinger[k] : -1;
+    if (linha < 0) return 0;
+    
+    tabela->linhas_eytzinger[k] = -1;
+    tabela->total_votos -= tabela->dados[linha].votos;
+    liberar_linha(tabela, linha);
+    tabela->quantidade--;
+    tabela->percentuais_pendentes = 1;
+    
+    // A chave fica no layout marcada; muitas delas justificam refazer
+    if (++tabela->removidas * 2 > tabela->num_eytzinger) tabela->layout_pendente = 1;
+    return 1;
+}
+
+ResultadoVotacao* buscar_resultado_por_id_tabela(TabelaResultados* tabela, int id) {
+    if (!tabela) return NULL;
+    
+    int linha = buscar_linha(tabela, id);
+    if (linha < 0 || !ativar_vistas(tabela)) return NULL;
+    return vista_linha(tabela, linha);
+}
+
+ResultadoVotacao* buscar_resultado_por_nome_tabela(TabelaResultados* tabela, const char* nome) {
+    if (!tabela || !nome) return NULL;
+    atualizar_percentuais_tabela(tabela);
+    
+    // Varredura linear, mas sobre um vetor contguo s de nomes
+    for (int linha = 0; linha < tabela->linhas_usadas; linha++) {
+        if (tabela->ocupada[linha] && strcmp(tabela->nomes[linha], nome) == 0) {
+            return ativar_vistas(tabela) ? vista_linha(tabela, linha) : NULL;
+        }
+    }
+    return NULL;
+}
+
+int atualizar_votos_resultado_tabela(TabelaResultados* tabela, int id, int votos_adicionais) {
+    if (!tabela) return 0;
+    
+    int linha = buscar_linha(tabela, id);
+    if (linha < 0) return 0;
+    
+    tabela->dados[linha].votos += votos_adicionais;
+    sincronizar_votos_vista(tabela, linha);
+    tabela->total_votos += votos_adicionais;
+    tabela->percentuais_pendentes = 1;
+    return 1;
+}
+
+// Mesmo critrio preguioso da rvore: s refaz se algum voto mudou
+int atualizar_percentuais_tabela(TabelaResultados* tabela) {
+    if (!tabela || tabela->total_votos == 0) return 0;
+    if (!tabela->percentuais_pendentes) return 1;
+    
+    for (int linha = 0; linha < tabela->linhas_usadas; linha++) {
+        if (tabela->ocupada[linha]) {
+            tabela->dados[linha].percentual = (float)tabela->dados[linha].votos / tabela->total_votos * 100;
+            if (tabela->vistas_ativas) vista_linha(tabela, linha)->percentual = tabela->dados[linha].percentual;
+        }
+    }
+    tabela->percentuais_pendentes = 0;
+    return 1;
+}
+
+int total_nos_tabela(TabelaResultados* tabela) {
+    return tabela ? tabela->quantidade : 0;
+}
+
+int soma_votos_tabela(TabelaResultados* tabela) {
+    return tabela ? tabela->total_votos : 0;
+}
+
+int tabela_vazia(TabelaResultados* tabela) {
+    return (!tabela || tabela->quantidade == 0);
+}
+
+void percorrer_tabela_resultados(TabelaResultados* tabela, OrdemPercurso ordem,
+                                 void (*callback)(ResultadoVotacao*, void*), void* contexto) {
+    if (!tabela || !callback) return;
+    if (tabela->layout_pendente && !refazer_layout(tabela)) return;
+    if (!ativar_vistas(tabela)) return;
+    
+    int reversa = (ordem == PERCURSO_EM_ORDEM_REVERSA);
+    for (int i = 0; i < tabela->num_ordenadas; i++) {
+        ParChaveResultado chave = tabela->ordenadas[reversa ? tabela->num_ordenadas - 1 - i : i];
+        if (!chave_valida(tabela, chave)) continue;
+        callback(vista_linha(tabela, chave.linha), contexto);
+    }
+}
+
+static int comparar_resultados_tabela(const void* a, const void* b) {
+    const ResultadoVotacao* ra = *(ResultadoVotacao* const*)a;
+    const ResultadoVotacao* rb = *(ResultadoVotacao* const*)b;
+    
+    if (ra->votos != rb->votos) return (ra->votos < rb->votos) ? 1 : -1;
+    return (ra->id > rb->id) - (ra->id < rb->id);
+}
+
+typedef struct {
+    ResultadoVotacao** destino;
+    int quantidade;
+} ColetaTabela;
+
+static void coletar_resultado_tabela(ResultadoVotacao* resultado, void* contexto) {
+    ColetaTabela* coleta = (ColetaTabela*)contexto;
+    coleta->destino[coleta->quantidade++] = resultado;
+}
+
+ResultadoVotacao** obter_resultados_ordenados_tabela(TabelaResultados* tabela, int ordem) {
+    if (!tabela) return NULL;
+    atualizar_percentuais_tabela(tabela);
+    
+    // Refaz o layout antes de contar: IDs repetidos pendentes ainda se fundem
+    if (tabela->layout_pendente && !refazer_layout(tabela)) return NULL;
+    
+    ColetaTabela coleta;
+    coleta.destino = (ResultadoVotacao**)malloc((tabela->quantidade > 0 ? tabela->quantidade : 1) * sizeof(ResultadoVotacao*));
+    if (!coleta.destino) return NULL;
+    coleta.quantidade = 0;
+    
+    percorrer_tabela_resultados(tabela, PERCURSO_EM_ORDEM, coletar_resultado_tabela, &coleta);
+    if (coleta.quantidade != tabela->quantidade) {
+        // Sem memria para as vistas
+        free(coleta.destino);
+        return NULL;
+    }
+    
+    if (ordem == 1) {
+        qsort(coleta.destino, coleta.quantidade, sizeof(ResultadoVotacao*), comparar_resultados_tabela);
+    }
+    
+    return coleta.destino;
+}
+
+static void exportar_linha_csv_tabela(ResultadoVotacao* resultado, void* contexto) {
+    EscritorSaida* saida = (EscritorSaida*)contexto;
+    
+    const char* tipo_str;
+    switch (resultado->tipo) {
+        case TIPO_CANDIDATO: tipo_str = "CANDIDATO;"; break;
+        case TIPO_CAP: tipo_str = "CAP;"; break;
+        case TIPO_REGIAO: tipo_str = "REGIAO;"; break;
+        default: tipo_str = "DESCONHECIDO;";
+    }
+    
+    escrever_texto(saida, tipo_str);
+    escrever_inteiro(saida, resultado->id);
+    escrever_bytes(saida, ";", 1);
+    escrever_campo_csv(saida, resultado->nome);
+    escrever_bytes(saida, ";", 1);
+    escrever_inteiro(saida, resultado->votos);
+    escrever_bytes(saida, ";", 1);
+    escrever_decimal(saida, resultado->percentual);
+    escrever_bytes(saida, "\n", 1);
+}
+
+int exportar_resultados_csv_tabela(TabelaResultados* tabela, const char* filename) {
+    if (!tabela || !filename) return 0;
+    
+    EscritorSaida* saida = criar_escritor_arquivo(filename, 0);
+    if (!saida) return 0;
+    
+    atualizar_percentuais_tabela(tabela);
+    escrever_texto(saida, "Tipo;ID;Nome;Votos;Percentual\n");
+    percorrer_tabela_resultados(tabela, PERCURSO_EM_ORDEM, exportar_linha_csv_tabela, saida);
+    if (!fechar_escritor(saida)) return 0;
+    
+    printf("Resultados exportados para %s\n", filename);
+    return 1;
+}
@@ -0,0 +1,107 @@
+#ifndef TABELA_RESULTADOS_H
+#define TABELA_RESULTADOS_H
+
+#include "estruturas.h"
+
+// ================= TABELA DE RESULTADOS (LAYOUT EYTZINGER) =================
+
+// Alternativa  ArvoreResultados para conjuntos grandes (milhares de CAPs
+// ou candidatos locais). As chaves ficam num vetor contguo em layout
+// Eytzinger, que a busca percorre como uma rvore implcita sem ponteiros;
+// os dados e os nomes ficam em vetores separados, indexados por linha.
+// Pensada para carga em lote seguida de consultas e contagem de votos:
+// inseres ficam pendentes e o layout  refeito na consulta seguinte.
+//
+// As funes tm as assinaturas das de arvore_resultados.h, com o sufixo
+// _tabela. O ResultadoVotacao* devolvido  uma vista da linha: fica no
+// mesmo endereo at o resultado ser removido e acompanha votos e
+// percentuais, como o ponteiro para o n da rvore. As vistas s so
+// montadas no primeiro pedido de ponteiro; quem s insere, conta votos e
+// busca linhas internamente no paga por elas.
+
+// Dados de um resultado sem o nome
+typedef struct DadosResultado {
+    int id;
+    TipoNoArvore tipo;
+    int votos;
+    int votos_validos;
+    int votos_brancos;
+    int votos_nulos;
+    float percentual;
+} DadosResultado;
+
+// Chave ordenvel: ID e linha onde esto os dados
+typedef struct ParChaveResultado {
+    int id;
+    int linha;
+} ParChaveResultado;
+
+typedef struct TabelaResultados {
+    // Linhas (pool): removidas voltam para a lista de livres
+    DadosResultado* dados;
+    char (*nomes)[MAX_NOME];
+    unsigned char* ocupada;
+    int* livres;
+    int num_livres;
+    int linhas_usadas;            // Linhas j entregues pelo pool
+    int capacidade_linhas;
+    
+    // Chaves vlidas em ordem de ID e inseres ainda no ordenadas
+    ParChaveResultado* ordenadas;
+    int num_ordenadas;
+    ParChaveResultado* novas;
+    int num_novas;
+    int capacidade_novas;
+    
+    // Layout Eytzinger de ordenadas (posio 0 sem uso)
+    int* chaves_eytzinger;
+    int* linhas_eytzinger;
+    int num_eytzinger;
+    int layout_pendente;          // 1 = refazer antes da prxima busca
+    int removidas;                // Chaves invlidas ainda no layout
+    
+    // Vistas por linha, em blocos que nunca mudam de endereo
+    ResultadoVotacao** blocos_vistas;
+    int num_blocos_vistas;
+    int vistas_ativas;            // 1 = vistas montadas e mantidas em dia
+    
+    int quantidade;               // Resultados na tabela
+    int total_votos;
+    int percentuais_pendentes;
+    TipoNoArvore tipo_tabela;
+} TabelaResultados;
+
+// Criao e destruio
+TabelaResultados* criar_tabela_resultados(TipoNoArvore tipo);
+void destruir_tabela_resultados(TabelaResultados* tabela);
+
+// Insero (ID repetido soma os votos, como na rvore) e remoo
+int inserir_resultado_tabela(TabelaResultados* tabela, ResultadoVotacao resultado);
+int remover_resultado_tabela(TabelaResultados* tabela, int id);
+
+// Busca
+ResultadoVotacao* buscar_resultado_por_id_tabela(TabelaResultados* tabela, int id);
+ResultadoVotacao* buscar_resultado_por_nome_tabela(TabelaResultados* tabela, const char* nome);
+
+// Atualizao
+int atualizar_votos_resultado_tabela(TabelaResultados* tabela, int id, int votos_adicionais);
+int atualizar_percentuais_tabela(TabelaResultados* tabela);
+
+// Consultas
+int total_nos_tabela(TabelaResultados* tabela);
+int soma_votos_tabela(TabelaResultados* tabela);
+int tabela_vazia(TabelaResultados* tabela);
+
+// Percurso com contexto. A tabela no tem forma de rvore: s a ordem
+// reversa muda algo, as demais saem em ordem de ID
+void percorrer_tabela_resultados(TabelaResultados* tabela, OrdemPercurso ordem,
+                                 void (*callback)(ResultadoVotacao*, void*), void* contexto);
+
+// Vetor com total_nos_tabela() resultados (ordem 1 = votos decrescentes,
+// empate pelo menor ID; outra = ordem de ID); liberar com free
+ResultadoVotacao** obter_resultados_ordenados_tabela(TabelaResultados* tabela, int ordem);
+
+// Exportao no mesmo formato de exportar_resultados_csv
+int exportar_resultados_csv_tabela(TabelaResultados* tabela, const char* filename);
+
+#endif
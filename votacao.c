@@ -5,8 +5,10 @@
 #include "votacao.h"
 #include "filas.h"
 #include "pilhas.h"
+#include "diario_operacoes.h"
 #include "eleitores.h"
 #include "candidatos.h"  // Adicione esta linha
+#include "caps.h"
 // ================= IMPLEMENTAO CONFIGURAO DO SISTEMA =================
 
 SistemaVotacao* criar_sistema_votacao(int usuario_admin) {
@@ -15,14 +17,21 @@ SistemaVotacao* criar_sistema_votacao(int usuario_admin) {
         sistema->votacao_ativa = false;
         sistema->inicio_votacao = 0;
         sistema->fim_votacao = 0;
-        sistema->historico_operacoes = criar_pilha_operacoes();
-        sistema->eleitores_atendidos = criar_pilha_eleitores_atendidos();
+        sistema->historico_operacoes = criar_historico_operacoes(CAPACIDADE_HISTORICO);
+        sistema->eleitores_atendidos = criar_registro_atendidos();
         sistema->usuario_logado = usuario_admin;
         
+        // Todas as operaes tambm vo para o dirio em disco
+        if (sistema->historico_operacoes) {
+            sistema->historico_operacoes->diario = abrir_diario_operacoes(ARQUIVO_DIARIO_OPERACOES);
+            if (!sistema->historico_operacoes->diario) {
+                printf("Aviso: diario de operacoes indisponivel, historico apenas em memoria.\n");
+            }
+        }
+        
         // Registrar operao de inicializao
-        registrar_operacao(sistema->historico_operacoes, 
-                          "SISTEMA", 
-                          "Sistema de votacao inicializado", 
+        registrar_operacao(sistema->historico_operacoes, OPERACAO_SISTEMA,
+                          SEM_REFERENCIA, SEM_REFERENCIA, SEM_REFERENCIA, SEM_REFERENCIA,
                           usuario_admin);
     }
     return sistema;
@@ -32,13 +41,13 @@ void destruir_sistema_votacao(SistemaVotacao* sistema) {
     if (!sistema) return;
     
     if (sistema->historico_operacoes) {
-        // Salvar histrico em arquivo antes de destruir
-        // (implementao opcional)
-        destruir_pilha(sistema->historico_operacoes);
+        // Gravar operaes pendentes no dirio antes de destruir
+        fechar_diario_operacoes(sistema->historico_operacoes->diario);
+        destruir_historico_operacoes(sistema->historico_operacoes);
     }
     
     if (sistema->eleitores_atendidos) {
-        destruir_pilha(sistema->eleitores_atendidos);
+        destruir_registro_atendidos(sistema->eleitores_atendidos);
     }
     
     free(sistema);
@@ -50,9 +59,8 @@ void iniciar_votacao(SistemaVotacao* sistema) {
     sistema->votacao_ativa = true;
     sistema->inicio_votacao = time(NULL);
     
-    registrar_operacao(sistema->historico_operacoes,
-                      "VOTACAO",
-                      "Votacao iniciada",
+    registrar_operacao(sistema->historico_operacoes, OPERACAO_ABERTURA,
+                      SEM_REFERENCIA, SEM_REFERENCIA, SEM_REFERENCIA, SEM_REFERENCIA,
                       sistema->usuario_logado);
     
     printf("=== VOTACAO INICIADA ===\n");
@@ -65,9 +73,8 @@ void encerrar_votacao(SistemaVotacao* sistema) {
     sistema->votacao_ativa = false;
     sistema->fim_votacao = time(NULL);
     
-    registrar_operacao(sistema->historico_operacoes,
-                      "VOTACAO",
-                      "Votacao encerrada",
+    registrar_operacao(sistema->historico_operacoes, OPERACAO_ENCERRAMENTO,
+                      SEM_REFERENCIA, SEM_REFERENCIA, SEM_REFERENCIA, SEM_REFERENCIA,
                       sistema->usuario_logado);
     
     printf("=== VOTACAO ENCERRADA ===\n");
@@ -88,6 +95,7 @@ Urna* criar_urna(int numero, int cap_id) {
         urna->numero = numero;
         urna->cap_id = cap_id;
         urna->votos_registrados = 0;
+        urna->votos_apurados = 0;
         urna->ativa = true;
         urna->historico_votos = criar_pilha_votos();
     }
@@ -100,7 +108,7 @@ void destruir_urna(Urna* urna) {
     if (urna->historico_votos) {
         // Salvar votos em arquivo antes de destruir
         // (implementao opcional)
-        destruir_pilha(urna->historico_votos);
+        destruir_pilha_votos(urna->historico_votos);
     }
     
     free(urna);
@@ -120,6 +128,29 @@ int total_votos_urna(Urna* urna) {
     return urna ? urna->votos_registrados : 0;
 }
 
+int alocar_urnas_cap(CAP* cap) {
+    if (!cap || cap->num_urnas <= 0) return 0;
+    if (cap->urnas) return 1;
+    
+    Urna** urnas = (Urna**)calloc(cap->num_urnas, sizeof(Urna*));
+    if (!urnas) return 0;
+    
+    // Urnas numeradas de 1 a num_urnas, cada uma com sua pilha de votos
+    for (int i = 0; i < cap->num_urnas; i++) {
+        urnas[i] = criar_urna(i + 1, cap->id);
+        if (!urnas[i] || !urnas[i]->historico_votos) {
+            for (int j = 0; j <= i; j++) {
+                destruir_urna(urnas[j]);
+            }
+            free(urnas);
+            return 0;
+        }
+    }
+    
+    cap->urnas = urnas;
+    return 1;
+}
+
 void imprimir_status_urna(Urna* urna) {
     if (!urna) {
         printf("Urna invalida!\n");
@@ -129,7 +160,7 @@ void imprimir_status_urna(Urna* urna) {
     printf("Urna %d (CAP %d):\n", urna->numero, urna->cap_id);
     printf("  Status: %s\n", urna->ativa ? "ATIVA" : "INATIVA");
     printf("  Votos registrados: %d\n", urna->votos_registrados);
-    printf("  Votos na pilha: %d\n", tamanho_pilha(urna->historico_votos));
+    printf("  Votos na pilha: %d\n", tamanho_pilha_votos(urna->historico_votos));
 }
 
 // ================= IMPLEMENTAO PROCESSO DE VOTAO =================
@@ -151,14 +182,8 @@ int eleitor_chega_cap(CAP* cap, Eleitor* eleitor, SistemaVotacao* sistema) {
     
     // Adicionar  fila do CAP
     if (adicionar_eleitor_cap_fila(cap, eleitor)) {
-        char descricao[200];
-        snprintf(descricao, sizeof(descricao), 
-                "Eleitor %s (%d) chegou ao CAP %d", 
-                eleitor->nome, eleitor->id, cap->id);
-        
-        registrar_operacao(sistema->historico_operacoes,
-                          "CHEGADA",
-                          descricao,
+        registrar_operacao(sistema->historico_operacoes, OPERACAO_CHEGADA,
+                          eleitor->id, SEM_REFERENCIA, cap->id, SEM_REFERENCIA,
                           sistema->usuario_logado);
         
         printf("Eleitor %s adicionado a fila do CAP %d\n", 
@@ -174,14 +199,8 @@ Eleitor* chamar_proximo_eleitor(CAP* cap, SistemaVotacao* sistema) {
     
     Eleitor* eleitor = proximo_eleitor_cap(cap);
     if (eleitor) {
-        char descricao[200];
-        snprintf(descricao, sizeof(descricao),
-                "Eleitor %s (%d) chamado para votar no CAP %d",
-                eleitor->nome, eleitor->id, cap->id);
-        
-        registrar_operacao(sistema->historico_operacoes,
-                          "CHAMADA",
-                          descricao,
+        registrar_operacao(sistema->historico_operacoes, OPERACAO_CHAMADA,
+                          eleitor->id, SEM_REFERENCIA, cap->id, SEM_REFERENCIA,
                           sistema->usuario_logado);
         
         printf("Proximo eleitor: %s (ID: %d)\n", eleitor->nome, eleitor->id);
@@ -191,7 +210,15 @@ Eleitor* chamar_proximo_eleitor(CAP* cap, SistemaVotacao* sistema) {
 }
 
 Urna* direcionar_para_urna(CAP* cap, Eleitor* eleitor) {
-    if (!cap || !eleitor || !cap->urnas) return NULL;
+    if (!cap || !eleitor) return NULL;
+    
+    // Urnas so criadas no primeiro eleitor do CAP
+    if (!alocar_urnas_cap(cap)) {
+        printf("Nao foi possivel preparar as urnas do CAP %d!\n", cap->id);
+        return NULL;
+    }
+    // O voto que vai entrar numa urna do CAP entra na prxima apurao
+    marcar_cap_pendente(cap);
     
     // Encontrar uma urna disponvel
     for (int i = 0; i < cap->num_urnas; i++) {
@@ -220,13 +247,9 @@ int registrar_voto_urna(Urna* urna, Eleitor* eleitor, int numero_candidato,
         return 0;
     }
     
-    // Criar voto
-    Voto* voto = criar_voto(eleitor->id, numero_candidato, urna->cap_id, urna->numero);
-    if (!voto) return 0;
-    
-    // Empilhar voto (registro temporrio)
+    // Criar voto e empilhar (registro temporrio, guardado por valor)
+    Voto voto = criar_voto(eleitor->id, numero_candidato, urna->cap_id, urna->numero);
     if (!empilhar_voto(urna->historico_votos, voto)) {
-        destruir_voto(voto);
         return 0;
     }
     
@@ -240,14 +263,8 @@ int registrar_voto_urna(Urna* urna, Eleitor* eleitor, int numero_candidato,
     }
     
     // Registrar operao
-    char descricao[200];
-    snprintf(descricao, sizeof(descricao),
-            "Voto registrado: Eleitor %d -> Candidato %d (Urna %d)",
-            eleitor->id, numero_candidato, urna->numero);
-    
-    registrar_operacao(sistema->historico_operacoes,
-                      "VOTO",
-                      descricao,
+    registrar_operacao(sistema->historico_operacoes, OPERACAO_VOTO,
+                      eleitor->id, numero_candidato, urna->cap_id, urna->numero,
                       sistema->usuario_logado);
     
     printf("Voto registrado com sucesso!\n");
@@ -263,18 +280,15 @@ void finalizar_voto_eleitor(Eleitor* eleitor, Urna* urna, SistemaVotacao* sistem
     // Liberar urna para prximo eleitor
     liberar_urna(urna);
     
-    // Adicionar  pilha de eleitores atendidos
-    empilhar_eleitor_atendido(sistema->eleitores_atendidos, eleitor);
+    // Marcar no registro de atendidos do CAP (bitmap + log de IDs)
+    if (!registrar_eleitor_atendido(sistema->eleitores_atendidos, urna->cap_id, eleitor->id)) {
+        printf("Aviso: eleitor %d nao entrou no registro de atendidos do CAP %d.\n",
+               eleitor->id, urna->cap_id);
+    }
     
     // Registrar operao
-    char descricao[200];
-    snprintf(descricao, sizeof(descricao),
-            "Voto finalizado: Eleitor %s (%d) na urna %d",
-            eleitor->nome, eleitor->id, urna->numero);
-    
-    registrar_operacao(sistema->historico_operacoes,
-                      "FINALIZACAO",
-                      descricao,
+    registrar_operacao(sistema->historico_operacoes, OPERACAO_FINALIZACAO,
+                      eleitor->id, SEM_REFERENCIA, urna->cap_id, urna->numero,
                       sistema->usuario_logado);
     
     printf("Voto finalizado para %s. Urna %d liberada.\n", 
@@ -440,6 +454,7 @@ void gerar_relatorio_votacao_cap(CAP* cap, SistemaVotacao* sistema) {
     printf("Capacidade total: %d\n", cap->num_urnas * cap->max_eleitores_por_urna);
     printf("\n");
     printf("Eleitores atendidos: %d\n", cap->eleitores_atendidos);
+    printf("Votos finalizados: %d\n", total_atendidos_cap(sistema->eleitores_atendidos, cap->id));
     printf("Eleitores na fila: %d\n", total_eleitores_na_fila_cap(cap));
     printf("Eleitores prioritarios na fila: %d\n", eleitores_prioritarios_na_fila_cap(cap));
     
@@ -459,6 +474,9 @@ void gerar_relatorio_votacao_cap(CAP* cap, SistemaVotacao* sistema) {
     }
     
     printf("Total de votos no CAP: %d\n", total_votos_cap);
+    
+    printf("\n");
+    imprimir_eleitores_atendidos(sistema->eleitores_atendidos, cap->id, 5);
 }
 
 void gerar_relatorio_urna(Urna* urna) {
@@ -468,10 +486,10 @@ void gerar_relatorio_urna(Urna* urna) {
     printf("CAP: %d\n", urna->cap_id);
     printf("Status: %s\n", urna->ativa ? "ATIVA" : "INATIVA");
     printf("Votos registrados: %d\n", urna->votos_registrados);
-    printf("Votos na pilha temporaria: %d\n", tamanho_pilha(urna->historico_votos));
+    printf("Votos na pilha temporaria: %d\n", tamanho_pilha_votos(urna->historico_votos));
     
     // Mostrar ltimos votos (se houver)
-    if (!pilha_vazia(urna->historico_votos)) {
+    if (!pilha_votos_vazia(urna->historico_votos)) {
         printf("\n=== ULTIMOS VOTOS REGISTRADOS ===\n");
         imprimir_pilha_votos(urna->historico_votos);
     }
@@ -490,6 +508,8 @@ void estatisticas_tempo_fila(CAP* cap) {
         printf("Taxa de ocupacao: %.1f%%\n", 
                (media_por_urna / cap->max_eleitores_por_urna) * 100);
     }
+    
+    imprimir_estatisticas_espera_cap(cap);
 }
 
 void imprimir_resultados_parciais(CAP* cap, ListaCandidatos* lista_candidatos) {
@@ -9,8 +9,8 @@ typedef struct SistemaVotacao {
     bool votacao_ativa;
     time_t inicio_votacao;
     time_t fim_votacao;
-    Pilha* historico_operacoes;
-    Pilha* eleitores_atendidos;
+    HistoricoOperacoes* historico_operacoes;
+    RegistroAtendidos* eleitores_atendidos;
     int usuario_logado; // ID do administrador ou mesrio
 } SistemaVotacao;
 
@@ -29,6 +29,7 @@ int urna_disponivel(Urna* urna);
 void liberar_urna(Urna* urna);
 int total_votos_urna(Urna* urna);
 void imprimir_status_urna(Urna* urna);
+int alocar_urnas_cap(CAP* cap);
 
 // ================= PROCESSO DE VOTAO =================
 